@@ -8,6 +8,22 @@ call "C:\Program Files\Microsoft Visual Studio\2022\Community\VC\Auxiliary\Build
 REM Navigate to build directory
 cd /d "%~dp0..\build"
 
+REM Check that the built-in scheme tables (src\core\BuiltinSchemes.hpp) match schemes\
+REM (only compares; regenerate and commit the header when this fails)
+echo Checking built-in schemes...
+cl /nologo /std:c++17 /O2 /utf-8 /EHsc /I"..\src" ..\src\tools\gen_builtin_schemes.cpp /Fe:gen_builtin_schemes.exe
+if errorlevel 1 (
+    echo Generator build failed!
+    pause
+    exit /b 1
+)
+gen_builtin_schemes.exe --check ..\schemes ..\src\core\BuiltinSchemes.hpp chinese default simple tones
+if errorlevel 1 (
+    echo Built-in schemes are out of date!
+    pause
+    exit /b 1
+)
+
 REM Compile all TSF source files
 echo Compiling TSF sources...
 cl /c /std:c++17 /utf-8 /EHsc /W3 /Zi ^
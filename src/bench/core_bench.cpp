@@ -0,0 +1,302 @@
+// 核心热路径基准：只依赖 src/core，不含任何 Windows 界面代码。
+// 用来对比改动前后的按键延迟，不是测试，不判断对错。
+//
+// 构建（在仓库根目录）:
+//   g++ -std=c++17 -O2 -pthread -Isrc src/bench/core_bench.cpp -o core_bench
+//   cl /std:c++17 /O2 /utf-8 /EHsc /I src src\bench\core_bench.cpp
+// 运行:
+//   core_bench [schemes_dir] [filter]
+//   schemes_dir 默认为 schemes/；filter 只跑名字里含该子串的项，例如 core_bench schemes/ keystroke
+//
+// 每一项报告 ns/op（平均）、allocs/op（全局 operator new 次数）以及单次样本的 p50/p90/p99/max。
+#include "core/Dic.hpp"
+#include "core/Engine.hpp"
+#include "core/Loader.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+// ---- 分配计数：替换全局 operator new ----
+static std::atomic<size_t> g_allocs{0};
+
+void* operator new(size_t size)
+{
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size) { return operator new(size); }
+
+// 与上面的 malloc 配对释放。GCC 把 delete 内联到调用点后只看得见 new 配 free，会误报
+// -Wmismatched-new-delete；这里本来就是 malloc/free 一对，所以只在这几行关掉它。
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+// ---- 计时 ----
+static std::string g_filter;
+
+// 跑 samples 个样本，每个样本先调用 setup（不计时），再计时调用 inner 次 op。
+// 延迟分位数按“每个样本的平均单次耗时”统计。
+static void measure(const std::string& name, size_t samples, size_t inner,
+                    const std::function<void(size_t)>& setup,
+                    const std::function<void(size_t)>& op)
+{
+    if (!g_filter.empty() && name.find(g_filter) == std::string::npos)
+        return;
+    using clock = std::chrono::steady_clock;
+
+    // 预热：填满缓存、让惰性初始化先发生
+    const size_t warmup = std::max<size_t>(1, samples / 10);
+    for (size_t s = 0; s < warmup; ++s) {
+        if (setup) setup(s);
+        for (size_t i = 0; i < inner; ++i) op(s * inner + i);
+    }
+
+    std::vector<double> per_op;
+    per_op.reserve(samples);
+    double total_ns = 0;
+    size_t allocs = 0;
+    for (size_t s = 0; s < samples; ++s) {
+        if (setup) setup(s);
+        size_t a0 = g_allocs.load(std::memory_order_relaxed);
+        auto t0 = clock::now();
+        for (size_t i = 0; i < inner; ++i) op(s * inner + i);
+        auto t1 = clock::now();
+        allocs += g_allocs.load(std::memory_order_relaxed) - a0;
+        double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        total_ns += ns;
+        per_op.push_back(ns / inner);
+    }
+
+    std::sort(per_op.begin(), per_op.end());
+    auto pct = [&](double p) { return per_op[std::min(per_op.size() - 1, (size_t)(p * per_op.size()))]; };
+    const double ops = (double)samples * inner;
+    std::printf("%-32s %10.0f %12.1f %10.2f %10.1f %10.1f %10.1f %10.1f\n",
+                name.c_str(), ops, total_ns / ops, allocs / ops,
+                pct(0.50), pct(0.90), pct(0.99), per_op.back());
+    std::fflush(stdout);
+}
+
+static void printHeader()
+{
+    std::printf("%-32s %10s %12s %10s %10s %10s %10s %10s\n",
+                "benchmark", "ops", "ns/op", "allocs/op", "p50", "p90", "p99", "max");
+}
+
+// 防止结果被优化掉
+static volatile size_t g_sink = 0;
+
+int main(int argc, char** argv)
+{
+    namespace fs = std::filesystem;
+    std::string dir = argc > 1 ? argv[1] : "schemes/";
+    if (argc > 2) g_filter = argv[2];
+
+    std::vector<fs::path> files;
+    try {
+        for (const auto& entry : fs::directory_iterator(dir)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".txt")
+                files.push_back(entry.path());
+        }
+    } catch (std::exception& e) {
+        std::fprintf(stderr, "Cannot read scheme directory %s: %s\n", dir.c_str(), e.what());
+        return 1;
+    }
+    std::sort(files.begin(), files.end());
+    if (files.empty()) {
+        std::fprintf(stderr, "No scheme files in %s\n", dir.c_str());
+        return 1;
+    }
+
+    // 与 SchemeLoader 默认启用的字库一致，日志丢掉
+    Dictionary dict;
+    {
+        SchemeLoader loader;
+        std::streambuf* out_buf = std::cout.rdbuf(nullptr);
+        loader.loadSchemes(dir, dict);
+        std::cout.rdbuf(out_buf);
+        std::cout.clear();
+    }
+
+    // 取样用的键和值：直接从源文本编译出一份镜像来遍历
+    std::vector<std::string> keys;
+    std::vector<std::string> tone_keys;
+    std::vector<std::u32string> values;
+    {
+        SchemeImageBuilder builder;
+        for (const auto& f : files) {
+            std::string name = f.stem().string();
+            if (name != "custom" && name != "simple" && name != "default" && name != "tones") continue;
+            builder.beginScheme(name);
+            Dictionary::parseSchemeText(f.string(), builder);
+        }
+        auto image = SchemeImage::fromBytes(builder.finish());
+        for (size_t s = 0; image && s < image->schemeCount(); ++s) {
+            for (auto* k = image->keysBegin(s); k != image->keysEnd(s); ++k) {
+                std::string key(image->key(*k));
+                if (Dictionary::tDigitCount(key) > 0) tone_keys.push_back(key);
+                else keys.push_back(key);
+                for (uint32_t v = 0; v < k->value_count; ++v)
+                    values.emplace_back(image->value(k->value_begin + v));
+            }
+        }
+    }
+    if (keys.empty() || values.empty()) {
+        std::fprintf(stderr, "No keys loaded from %s\n", dir.c_str());
+        return 1;
+    }
+
+    std::mt19937 rng(20240601);
+    std::shuffle(keys.begin(), keys.end(), rng);
+
+    // 按真实打字的样子拼输入：随机键首尾相接，截到需要的长度
+    auto makeInput = [&](size_t len, const std::vector<std::string>& pool, uint32_t seed) {
+        std::mt19937 r(seed);
+        std::string s;
+        while (s.size() < len) s += pool[r() % pool.size()];
+        s.resize(len);
+        return s;
+    };
+
+    printHeader();
+
+    // ---- 加载 ----
+    for (const auto& f : files) {
+        std::string path = f.string();
+        measure("load/" + f.stem().string(), 20, 1, nullptr, [&](size_t) {
+            Dictionary d;
+            d.load(path);
+            g_sink += d.generation();
+        });
+    }
+    // compiled：全部从 schemes.bin 合并；builtin：自带字库直接查编进程序的表（要读文件核对指纹）
+    for (bool builtin : {false, true}) {
+        measure(builtin ? "loadSchemes/builtin" : "loadSchemes/compiled", 50, 1, nullptr, [&](size_t) {
+            Dictionary d;
+            SchemeLoader loader;
+            if (!builtin) loader.setBuiltinSchemes(nullptr);
+            std::streambuf* out_buf = std::cout.rdbuf(nullptr);
+            loader.loadSchemes(dir, d);
+            std::cout.rdbuf(out_buf);
+            std::cout.clear();
+            g_sink += d.generation();
+        });
+    }
+    // 启动时先用的那一份：不读任何文件
+    measure("attachBuiltinSchemes", 200, 1, nullptr, [&](size_t) {
+        Dictionary d;
+        SchemeLoader loader;
+        g_sink += loader.attachBuiltinSchemes(d, dir);
+    });
+
+    // ---- 查表 ----
+    std::vector<std::string> misses;
+    for (size_t i = 0; i < 1024; ++i) misses.push_back(makeInput(3 + i % 5, keys, (uint32_t)i) + "~");
+
+    measure("Lookup/hit", 1000, 256, nullptr, [&](size_t i) {
+        g_sink += dict.Lookup(keys[i % keys.size()]).size();
+    });
+    measure("Lookup/miss", 1000, 256, nullptr, [&](size_t i) {
+        g_sink += dict.Lookup(misses[i % misses.size()]).size();
+    });
+    for (size_t plen = 1; plen <= 3; ++plen) {
+        std::vector<std::string> prefixes;
+        for (const auto& k : keys)
+            if (k.size() >= plen) prefixes.push_back(k.substr(0, plen));
+        if (prefixes.empty()) continue;
+        measure("LookupByPrefix/len" + std::to_string(plen), 200, 8, nullptr, [&, prefixes](size_t i) {
+            g_sink += dict.LookupByPrefix(prefixes[i % prefixes.size()]).size();
+        });
+    }
+
+    // ---- 候选：按键延迟与冷启动 ----
+    // keystroke/L：buffer 里已有 L-1 个字符，计时“敲第 L 个字符 + 取候选栏”
+    auto keystroke = [&](const std::string& prefix, const std::vector<std::string>& pool, size_t maxLen, size_t samples) {
+        for (size_t len = 1; len <= maxLen; ++len) {
+            std::vector<std::string> inputs;
+            for (uint32_t s = 0; s < 16; ++s) inputs.push_back(makeInput(len, pool, s * 7919 + (uint32_t)len));
+            std::vector<std::unique_ptr<Engine>> engines;
+            for (const auto& in : inputs) {
+                engines.push_back(std::make_unique<Engine>(&dict));
+                for (size_t c = 0; c + 1 < in.size(); ++c) engines.back()->inputChar(in[c]);
+            }
+            char label[16];
+            std::snprintf(label, sizeof(label), "%02zu", len);
+            measure(prefix + label, samples, 1,
+                [&](size_t s) {
+                    Engine& e = *engines[s % engines.size()];
+                    if (e.getBuffer().size() == len) e.deleteLastChar();
+                },
+                [&](size_t s) {
+                    Engine& e = *engines[s % engines.size()];
+                    e.inputChar(inputs[s % inputs.size()].back());
+                    g_sink += e.getCandidates().size();
+                });
+        }
+    };
+    keystroke("keystroke/", keys, 24, 200);
+
+    // cold/L：新建 Engine，敲入全部 L 个字符后取一次候选栏
+    for (size_t len : {1, 4, 8, 12, 16, 20, 24}) {
+        std::vector<std::string> inputs;
+        for (uint32_t s = 0; s < 16; ++s) inputs.push_back(makeInput(len, keys, s * 104729 + (uint32_t)len));
+        char label[16];
+        std::snprintf(label, sizeof(label), "%02zu", len);
+        measure(std::string("cold/") + label, 100, 1, nullptr, [&](size_t s) {
+            Engine e(&dict);
+            for (char c : inputs[s % inputs.size()]) e.inputChar(c);
+            g_sink += e.getCandidates().size();
+        });
+    }
+
+    // ---- 声调：T-pattern 密集的输入（tones.txt 的键首尾相接，如 T132T5T214） ----
+    if (!tone_keys.empty()) {
+        keystroke("tones/keystroke/", tone_keys, 24, 200);
+        std::vector<std::string> mixed;  // 音节 + 声调交替，更接近实际
+        for (size_t i = 0; i < 256; ++i) mixed.push_back(keys[i % keys.size()] + tone_keys[(i * 31) % tone_keys.size()]);
+        keystroke("tones/mixed/", mixed, 24, 200);
+    }
+
+    // ---- UTF 转换 ----
+    std::vector<std::string> utf8_values;
+    for (const auto& v : values) utf8_values.push_back(utf32_to_utf8(v));
+    std::u32string long32;
+    while (long32.size() < 256) long32 += values[long32.size() % values.size()];
+    std::string long8 = utf32_to_utf8(long32);
+
+    measure("utf8_to_utf32/value", 1000, 256, nullptr, [&](size_t i) {
+        g_sink += utf8_to_utf32(utf8_values[i % utf8_values.size()]).size();
+    });
+    measure("utf32_to_utf8/value", 1000, 256, nullptr, [&](size_t i) {
+        g_sink += utf32_to_utf8(values[i % values.size()]).size();
+    });
+    measure("utf8_to_utf32/256cp", 1000, 16, nullptr, [&](size_t) {
+        g_sink += utf8_to_utf32(long8).size();
+    });
+    measure("utf32_to_utf8/256cp", 1000, 16, nullptr, [&](size_t) {
+        g_sink += utf32_to_utf8(long32).size();
+    });
+    measure("utf8_to_utf32/ascii", 1000, 256, nullptr, [&](size_t i) {
+        g_sink += utf8_to_utf32(keys[i % keys.size()]).size();
+    });
+
+    return 0;
+}
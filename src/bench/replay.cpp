@@ -0,0 +1,358 @@
+// 按键回放：读一份按键记录，按 ScripaTSF / 候选窗口的按键语义驱动 Engine，输出提交的文本和每个按键的延迟，
+// 可与金标准输出比对。只依赖 src/core，不含任何 Windows 界面代码，Linux 上直接跑。
+// 用来抓排名回归（同样的按键选出了不同的字）和延迟回归，不是单元测试。
+//
+// 构建（在仓库根目录）:
+//   g++ -std=c++17 -O2 -pthread -Isrc src/bench/replay.cpp -o replay
+//   cl /std:c++17 /O2 /utf-8 /EHsc /I src src\bench\replay.cpp
+// 运行:
+//   replay [选项] LOG...
+//     --schemes DIR   字库目录，默认 schemes/
+//     --page N        每页候选数，默认 8（与候选窗口一致）
+//     --beam B        束搜索宽度，默认 0（精确搜索）
+//     --pages         输出每个按键后的输入码与当前页候选，而不只是提交的文本（排名变化也能比出来）
+//     --out FILE      输出写到 FILE，默认 stdout
+//     --golden FILE   与 FILE 比对，不一致时报告第一处不同并以 1 退出
+//     --repeat N      整份记录回放 N 次，延迟取全部 N 次；每次输出必须一致
+//     --p99-budget US 任一类按键的 p99 超过 US 微秒时以 1 退出
+//
+// 记录格式：每行一个事件，# 开头为注释，空行忽略。
+//   type TEXT   依次敲 TEXT 的每个字符（数字在这里是声调等输入码，相当于小键盘数字）
+//   space       有候选时提交第一个；没有时输出一个空格
+//   enter       有候选时提交第一个；没有时输出换行
+//   select N    大键盘数字 N（1-9）：提交当前页第 N 个候选，没有就忽略
+//   next / prev 翻页（PageDown/PageUp 或 ] [）
+//   back        退格：有输入码时删一个字符，否则删掉已输出的最后一个字
+//   toggle      切换 IPA/ENG 模式
+//   reset       清空输入码（例如换了一个输入框）
+#include "core/Dic.hpp"
+#include "core/Engine.hpp"
+#include "core/Loader.hpp"
+#include "core/Trace.hpp"
+#include "core/Utf.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct Event {
+    enum class Kind { Type, Space, Enter, Select, Next, Prev, Back, Toggle, Reset, Count };
+    Kind kind;
+    std::string text;  // Type：要敲的字符
+    int index = 0;     // Select：1-9
+    size_t line = 0;   // 在记录文件里的行号，报错用
+};
+
+static const char* kindName(Event::Kind k)
+{
+    static const char* const names[] = {"type", "space", "enter", "select", "next", "prev", "back", "toggle", "reset"};
+    return names[static_cast<size_t>(k)];
+}
+
+static bool parseLog(const std::string& path, std::vector<Event>& events)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        std::cerr << "Cannot open keystroke log: " << path << "\n";
+        return false;
+    }
+    std::string line;
+    size_t no = 0;
+    while (std::getline(in, line)) {
+        ++no;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+        size_t sp = line.find(' ');
+        std::string word = line.substr(0, sp);
+        std::string arg = sp == std::string::npos ? "" : line.substr(sp + 1);
+        Event e{Event::Kind::Count, {}, 0, no};
+        if (word == "type" && !arg.empty()) { e.kind = Event::Kind::Type; e.text = arg; }
+        else if (word == "space") e.kind = Event::Kind::Space;
+        else if (word == "enter") e.kind = Event::Kind::Enter;
+        else if (word == "select") { e.kind = Event::Kind::Select; e.index = std::atoi(arg.c_str()); }
+        else if (word == "next") e.kind = Event::Kind::Next;
+        else if (word == "prev") e.kind = Event::Kind::Prev;
+        else if (word == "back") e.kind = Event::Kind::Back;
+        else if (word == "toggle") e.kind = Event::Kind::Toggle;
+        else if (word == "reset") e.kind = Event::Kind::Reset;
+        if (e.kind == Event::Kind::Count || (e.kind == Event::Kind::Select && (e.index < 1 || e.index > 9))) {
+            std::cerr << path << ":" << no << ": unknown event: " << line << "\n";
+            return false;
+        }
+        events.push_back(std::move(e));
+    }
+    return true;
+}
+
+// 一次回放的会话：Engine + 当前页码 + 已提交的文本
+class Session {
+public:
+    Session(const Dictionary* dict, size_t perPage, size_t beam, bool pages)
+        : engine_(dict), per_page_(perPage), pages_(pages)
+    {
+        engine_.setBeamWidth(beam);
+    }
+
+    // 执行一个按键并像候选窗口那样取当前页（多取一个判断有没有下一页），返回耗时（纳秒）
+    uint64_t key(Event::Kind kind, char c, int index)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        apply(kind, c, index);
+        page_items_.clear();
+        if (engine_.getMode() == Engine::Mode::IPA && !engine_.getBuffer().empty())
+            page_items_ = engine_.candidates(per_page_ + 1, page_ * per_page_);
+        auto t1 = std::chrono::steady_clock::now();
+        if (pages_) transcript(kind, c, index);
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+    }
+
+    const std::string& output() const { return out_; }
+
+private:
+    void commit(std::u32string_view text)
+    {
+        if (!pages_) out_ += utf32_to_utf8(text);
+        else note_ += "\t=" + utf32_to_utf8(text);
+        committed_ += text;
+    }
+    void emit(char32_t ch)
+    {
+        char32_t buf[1] = {ch};
+        commit(std::u32string_view(buf, 1));
+    }
+
+    bool hasCandidate(size_t index) const { return !engine_.candidates(1, index).empty(); }
+
+    void apply(Event::Kind kind, char c, int index)
+    {
+        const bool ipa = engine_.getMode() == Engine::Mode::IPA;
+        switch (kind) {
+        case Event::Kind::Type:
+            engine_.inputChar(c);
+            if (!ipa) emit(static_cast<unsigned char>(c));  // ENG 模式直接上屏
+            page_ = 0;
+            break;
+        case Event::Kind::Space:
+        case Event::Kind::Enter:
+            if (ipa && hasCandidate(0)) {
+                commit(engine_.chooseCandidate(0));
+            } else {
+                if (!ipa) engine_.inputChar(kind == Event::Kind::Space ? ' ' : '\n');
+                emit(kind == Event::Kind::Space ? U' ' : U'\n');
+            }
+            page_ = 0;
+            break;
+        case Event::Kind::Select: {
+            const size_t i = page_ * per_page_ + static_cast<size_t>(index - 1);
+            if (ipa && hasCandidate(i)) {
+                commit(engine_.chooseCandidate(i));
+                page_ = 0;
+            }
+            break;
+        }
+        case Event::Kind::Next:
+            if (ipa && hasCandidate((page_ + 1) * per_page_)) ++page_;
+            break;
+        case Event::Kind::Prev:
+            if (page_ > 0) --page_;
+            break;
+        case Event::Kind::Back:
+            if (!engine_.getBuffer().empty()) {
+                engine_.deleteLastChar();
+            } else if (!committed_.empty()) {
+                committed_.pop_back();
+                if (!pages_) out_ = utf32_to_utf8(committed_);
+                else note_ += "\t<";
+            }
+            page_ = 0;
+            break;
+        case Event::Kind::Toggle:
+            engine_.toggleMode();
+            page_ = 0;
+            break;
+        case Event::Kind::Reset:
+            engine_.clearBuffer();
+            page_ = 0;
+            break;
+        case Event::Kind::Count:
+            break;
+        }
+    }
+
+    // --pages：每个按键一行：事件、上屏的文本（=）或退格删掉的字（<）、输入码、页码，再是当前页的候选
+    void transcript(Event::Kind kind, char c, int index)
+    {
+        out_ += kindName(kind);
+        if (kind == Event::Kind::Type) { out_ += ' '; out_ += c; }
+        if (kind == Event::Kind::Select) out_ += ' ' + std::to_string(index);
+        out_ += note_;
+        note_.clear();
+        out_ += "\t[" + engine_.getBuffer() + "]\tp" + std::to_string(page_);
+        const size_t shown = std::min(page_items_.size(), per_page_);
+        for (size_t i = 0; i < shown; ++i) out_ += '\t' + utf32_to_utf8(page_items_[i]);
+        if (page_items_.size() > per_page_) out_ += "\t>";
+        out_ += '\n';
+    }
+
+    Engine engine_;
+    size_t per_page_;
+    bool pages_;
+    size_t page_ = 0;
+    std::vector<std::u32string> page_items_;
+    std::u32string committed_;  // 已上屏的文本（退格会删）
+    std::string out_;
+    std::string note_;          // --pages：本次按键上屏或删掉的文本，写在该按键那一行
+};
+
+static void printUsage(const char* argv0)
+{
+    std::cerr << "Usage: " << argv0 << " [--schemes DIR] [--page N] [--beam B] [--pages] [--out FILE]\n"
+              << "       [--golden FILE] [--repeat N] [--p99-budget US] LOG...\n";
+}
+
+int main(int argc, char** argv)
+{
+    std::string schemesDir = "schemes/";
+    std::string outPath, goldenPath;
+    size_t perPage = 8, beam = 0, repeat = 1;
+    double budgetUs = 0;
+    bool pages = false;
+    std::vector<std::string> logs;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() { return i + 1 < argc ? std::string(argv[++i]) : std::string(); };
+        if (arg == "--schemes") schemesDir = value();
+        else if (arg == "--page") perPage = static_cast<size_t>(std::max(1L, std::atol(value().c_str())));
+        else if (arg == "--beam") beam = static_cast<size_t>(std::max(0L, std::atol(value().c_str())));
+        else if (arg == "--pages") pages = true;
+        else if (arg == "--out") outPath = value();
+        else if (arg == "--golden") goldenPath = value();
+        else if (arg == "--repeat") repeat = static_cast<size_t>(std::max(1L, std::atol(value().c_str())));
+        else if (arg == "--p99-budget") budgetUs = std::atof(value().c_str());
+        else if (arg == "-h" || arg == "--help") { printUsage(argv[0]); return 0; }
+        else if (!arg.empty() && arg[0] == '-') { printUsage(argv[0]); return 2; }
+        else logs.push_back(arg);
+    }
+    if (logs.empty()) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    std::vector<Event> events;
+    for (const auto& path : logs) {
+        if (!parseLog(path, events))
+            return 2;
+    }
+
+    Dictionary dict;
+    {
+        SchemeLoader loader;
+        std::streambuf* out_buf = std::cout.rdbuf(std::cerr.rdbuf());  // 加载日志写到 stderr
+        int count = loader.loadSchemes(schemesDir, dict);
+        std::cout.rdbuf(out_buf);
+        if (count == 0) {
+            std::cerr << "No scheme files loaded from " << schemesDir << "\n";
+            return 2;
+        }
+    }
+
+    // 每类按键一个直方图；每次回放都从新的 Engine 开始，词格缓存不跨回放
+    LatencyHistogram latency[static_cast<size_t>(Event::Kind::Count)];
+    LatencyHistogram all;
+    std::string output;
+    for (size_t r = 0; r < repeat; ++r) {
+        Session session(&dict, perPage, beam, pages);
+        for (const auto& e : events) {
+            if (e.kind == Event::Kind::Type) {
+                for (char c : e.text) {
+                    uint64_t ns = session.key(e.kind, c, 0);
+                    latency[static_cast<size_t>(e.kind)].record(ns);
+                    all.record(ns);
+                }
+            } else {
+                uint64_t ns = session.key(e.kind, 0, e.index);
+                latency[static_cast<size_t>(e.kind)].record(ns);
+                all.record(ns);
+            }
+        }
+        if (r == 0) {
+            output = session.output();
+        } else if (session.output() != output) {
+            std::cerr << "Replay " << r + 1 << " produced different output than replay 1\n";
+            return 1;
+        }
+    }
+
+    if (outPath.empty()) {
+        std::cout << output;
+        if (!pages && !output.empty() && output.back() != '\n') std::cout << '\n';
+        std::cout.flush();
+    } else {
+        std::ofstream out(outPath, std::ios::binary | std::ios::trunc);
+        out << output;
+        if (!out) {
+            std::cerr << "Cannot write " << outPath << "\n";
+            return 2;
+        }
+    }
+
+    // 延迟摘要写到 stderr，stdout 只留回放输出
+    int status = 0;
+    char line[160];
+    std::snprintf(line, sizeof(line), "%-8s %10s %10s %10s %10s %10s %10s\n",
+                  "key(us)", "count", "mean", "p50", "p95", "p99", "max");
+    std::cerr << line;
+    auto report = [&](const char* name, const LatencyHistogram& h) {
+        LatencyHistogram::Summary s = h.summary();
+        if (s.count == 0) return;
+        std::snprintf(line, sizeof(line), "%-8s %10llu %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+                      name, static_cast<unsigned long long>(s.count), s.mean / 1e3,
+                      s.p50 / 1e3, s.p95 / 1e3, s.p99 / 1e3, s.max / 1e3);
+        std::cerr << line;
+        if (budgetUs > 0 && s.p99 / 1e3 > budgetUs) {
+            std::cerr << "  p99 of " << name << " exceeds the budget of " << budgetUs << " us\n";
+            status = 1;
+        }
+    };
+    for (size_t k = 0; k < static_cast<size_t>(Event::Kind::Count); ++k)
+        report(kindName(static_cast<Event::Kind>(k)), latency[k]);
+    report("all", all);
+
+    if (!goldenPath.empty()) {
+        std::ifstream in(goldenPath, std::ios::binary);
+        if (!in.is_open()) {
+            std::cerr << "Cannot open golden output: " << goldenPath << "\n";
+            return 2;
+        }
+        std::stringstream ss;
+        ss << in.rdbuf();
+        std::string golden = ss.str();
+        // 金标准文件末尾多一个换行不算不同（stdout 输出会补一个）
+        if (!pages && !golden.empty() && golden.back() == '\n' && (output.empty() || output.back() != '\n'))
+            golden.pop_back();
+        if (golden != output) {
+            size_t pos = 0, lineNo = 1;
+            while (pos < golden.size() && pos < output.size() && golden[pos] == output[pos]) {
+                if (golden[pos] == '\n') ++lineNo;
+                ++pos;
+            }
+            auto excerpt = [&](const std::string& s) {
+                size_t from = s.rfind('\n', pos ? pos - 1 : 0);
+                from = (from == std::string::npos || from >= pos) ? 0 : from + 1;
+                size_t to = s.find('\n', pos);
+                return s.substr(from, (to == std::string::npos ? s.size() : to) - from);
+            };
+            std::cerr << "Output differs from " << goldenPath << " at line " << lineNo << ":\n"
+                      << "  expected: " << excerpt(golden) << "\n"
+                      << "  actual:   " << excerpt(output) << "\n";
+            status = 1;
+        } else {
+            std::cerr << "Output matches " << goldenPath << "\n";
+        }
+    }
+    return status;
+}
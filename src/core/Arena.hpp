@@ -0,0 +1,110 @@
+#pragma once
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+
+// 单次查询用的内存池：指针递增分配，只能整体清空或退回到记下的位置；对象须可平凡析构
+class Arena {
+public:
+    struct Mark {
+        size_t block = 0;
+        size_t used = 0;
+    };
+
+    explicit Arena(size_t block_size = 16 * 1024) : block_size_(block_size) {}
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* allocate(size_t bytes, size_t align);
+    template <class T, class... Args>
+    T* create(Args&&... args);
+    std::u32string_view copy(std::u32string_view s); // 复制到池里，返回指向池的视图
+
+    Mark mark() const { return {current_, used_}; }
+    void rewind(Mark m); // 退回到 m：m 之后分配的内存全部作废
+    void reset() { rewind(Mark{}); }
+
+private:
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+    std::vector<Block> blocks_;
+    size_t current_ = 0;  // 正在使用的块；之后的块都是空闲的备用块
+    size_t used_ = 0;     // 当前块已用字节数
+    size_t block_size_;
+};
+
+// 让标准容器从 Arena 取内存；释放是空操作，内存随 Arena 清空一起回收
+template <class T>
+struct ArenaAllocator {
+    using value_type = T;
+
+    Arena* arena;
+
+    explicit ArenaAllocator(Arena* a) : arena(a) {}
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(size_t n) { return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T*, size_t) {}
+
+    template <class U>
+    bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+    template <class U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+};
+// 执行层
+inline void* Arena::allocate(size_t bytes, size_t align)
+{
+    for (;;) {
+        if (current_ < blocks_.size()) {
+            Block& b = blocks_[current_];
+            size_t start = (used_ + align - 1) & ~(align - 1);
+            if (start + bytes <= b.size) {
+                used_ = start + bytes;
+                return b.data.get() + start;
+            }
+            if (used_ == 0) {
+                // 空块也放不下：换成够大的
+                b.size = (std::max)(block_size_, bytes + align);
+                b.data.reset(new char[b.size]);
+                continue;
+            }
+            ++current_;
+            used_ = 0;
+            continue;
+        }
+        blocks_.push_back({std::unique_ptr<char[]>(new char[(std::max)(block_size_, bytes + align)]),
+                           (std::max)(block_size_, bytes + align)});
+        current_ = blocks_.size() - 1;
+        used_ = 0;
+    }
+}
+
+template <class T, class... Args>
+inline T* Arena::create(Args&&... args)
+{
+    static_assert(std::is_trivially_destructible<T>::value, "Arena never runs destructors");
+    return new (allocate(sizeof(T), alignof(T))) T{std::forward<Args>(args)...};
+}
+
+inline std::u32string_view Arena::copy(std::u32string_view s)
+{
+    if (s.empty())
+        return {};
+    auto* p = static_cast<char32_t*>(allocate(s.size() * sizeof(char32_t), alignof(char32_t)));
+    std::memcpy(p, s.data(), s.size() * sizeof(char32_t));
+    return {p, s.size()};
+}
+
+inline void Arena::rewind(Mark m)
+{
+    current_ = m.block;
+    used_ = m.used;
+}
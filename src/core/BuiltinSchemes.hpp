@@ -0,0 +1,1142 @@
+#pragma once
+// 由 src/tools/gen_builtin_schemes.cpp 生成，不要手改。自带字库改了以后重新生成：
+//   gen_builtin_schemes schemes src/core/BuiltinSchemes.hpp chinese default simple tones
+// 4 schemes, 310 keys, 385 nodes, 272 values
+#include "Dic.hpp"
+
+inline constexpr StaticSchemes::Scheme kBuiltinSchemeSources[] = {
+    {"chinese", 21u, 0x2a6b0a13e1ee9e9bull},
+    {"default", 1354u, 0xd180a7e5b927f8a5ull},
+    {"simple", 14u, 0xf006da814f5349cfull},
+    {"tones", 1297u, 0x3f3d923d2044d8e3ull},
+};
+
+inline constexpr std::u32string_view kBuiltinSchemeValues[] = {
+    {U"0.0.329", 7},
+    {U"a", 1},
+    {U"b", 1},
+    {U"c", 1},
+    {U"d", 1},
+    {U"e", 1},
+    {U"e\U0000031E", 2},
+    {U"f", 1},
+    {U"g", 1},
+    {U"h", 1},
+    {U"i", 1},
+    {U"j", 1},
+    {U"k", 1},
+    {U"l", 1},
+    {U"m", 1},
+    {U"n", 1},
+    {U"o", 1},
+    {U"o\U0000031E", 2},
+    {U"p", 1},
+    {U"q", 1},
+    {U"r", 1},
+    {U"s", 1},
+    {U"t", 1},
+    {U"u", 1},
+    {U"v", 1},
+    {U"x", 1},
+    {U"y", 1},
+    {U"z", 1},
+    {U"\U000000B2", 1},
+    {U"\U000000B2\U000000B2", 2},
+    {U"\U000000B2\U000000B3", 2},
+    {U"\U000000B2\U000000B3\U000000B9", 3},
+    {U"\U000000B2\U000000B3\U00002074", 3},
+    {U"\U000000B2\U000000B3\U00002075", 3},
+    {U"\U000000B2\U000000B9", 2},
+    {U"\U000000B2\U000000B9\U000000B3", 3},
+    {U"\U000000B2\U000000B9\U00002074", 3},
+    {U"\U000000B2\U000000B9\U00002075", 3},
+    {U"\U000000B2\U00002074", 2},
+    {U"\U000000B2\U00002074\U000000B3", 3},
+    {U"\U000000B2\U00002074\U000000B9", 3},
+    {U"\U000000B2\U00002074\U00002075", 3},
+    {U"\U000000B2\U00002075", 2},
+    {U"\U000000B2\U00002075\U000000B3", 3},
+    {U"\U000000B2\U00002075\U000000B9", 3},
+    {U"\U000000B2\U00002075\U00002074", 3},
+    {U"\U000000B3", 1},
+    {U"\U000000B3\U000000B2", 2},
+    {U"\U000000B3\U000000B2\U000000B9", 3},
+    {U"\U000000B3\U000000B2\U00002074", 3},
+    {U"\U000000B3\U000000B2\U00002075", 3},
+    {U"\U000000B3\U000000B3", 2},
+    {U"\U000000B3\U000000B9", 2},
+    {U"\U000000B3\U000000B9\U000000B2", 3},
+    {U"\U000000B3\U000000B9\U00002074", 3},
+    {U"\U000000B3\U000000B9\U00002075", 3},
+    {U"\U000000B3\U00002074", 2},
+    {U"\U000000B3\U00002074\U000000B2", 3},
+    {U"\U000000B3\U00002074\U000000B9", 3},
+    {U"\U000000B3\U00002074\U00002075", 3},
+    {U"\U000000B3\U00002075", 2},
+    {U"\U000000B3\U00002075\U000000B2", 3},
+    {U"\U000000B3\U00002075\U000000B9", 3},
+    {U"\U000000B3\U00002075\U00002074", 3},
+    {U"\U000000B9", 1},
+    {U"\U000000B9\U000000B2", 2},
+    {U"\U000000B9\U000000B2\U000000B3", 3},
+    {U"\U000000B9\U000000B2\U00002074", 3},
+    {U"\U000000B9\U000000B2\U00002075", 3},
+    {U"\U000000B9\U000000B3", 2},
+    {U"\U000000B9\U000000B3\U000000B2", 3},
+    {U"\U000000B9\U000000B3\U00002074", 3},
+    {U"\U000000B9\U000000B3\U00002075", 3},
+    {U"\U000000B9\U000000B9", 2},
+    {U"\U000000B9\U00002074", 2},
+    {U"\U000000B9\U00002074\U000000B2", 3},
+    {U"\U000000B9\U00002074\U000000B3", 3},
+    {U"\U000000B9\U00002074\U00002075", 3},
+    {U"\U000000B9\U00002075", 2},
+    {U"\U000000B9\U00002075\U000000B2", 3},
+    {U"\U000000B9\U00002075\U000000B3", 3},
+    {U"\U000000B9\U00002075\U00002074", 3},
+    {U"\U000000E4", 1},
+    {U"\U000000E6", 1},
+    {U"\U000000E7", 1},
+    {U"\U000000F0", 1},
+    {U"\U000000F8", 1},
+    {U"\U000000F8\U0000031E", 2},
+    {U"\U00000127", 1},
+    {U"\U0000014B", 1},
+    {U"\U00000153", 1},
+    {U"\U000001C0", 1},
+    {U"\U000001C1", 1},
+    {U"\U000001C2", 1},
+    {U"\U000001C3", 1},
+    {U"\U00000221", 1},
+    {U"\U00000235", 1},
+    {U"\U00000236", 1},
+    {U"\U00000250", 1},
+    {U"\U00000251", 1},
+    {U"\U00000252", 1},
+    {U"\U00000252\U00000308", 2},
+    {U"\U00000253", 1},
+    {U"\U00000254", 1},
+    {U"\U00000255", 1},
+    {U"\U00000256", 1},
+    {U"\U00000257", 1},
+    {U"\U00000258", 1},
+    {U"\U00000259", 1},
+    {U"\U0000025B", 1},
+    {U"\U0000025C", 1},
+    {U"\U0000025E", 1},
+    {U"\U0000025F", 1},
+    {U"\U00000260", 1},
+    {U"\U00000262", 1},
+    {U"\U00000263", 1},
+    {U"\U00000264", 1},
+    {U"\U00000264\U0000031E", 2},
+    {U"\U00000265", 1},
+    {U"\U00000266", 1},
+    {U"\U00000268", 1},
+    {U"\U00000268\U0000031E", 2},
+    {U"\U0000026A", 1},
+    {U"\U0000026B", 1},
+    {U"\U0000026C", 1},
+    {U"\U0000026D", 1},
+    {U"\U0000026D\U00000306", 2},
+    {U"\U0000026E", 1},
+    {U"\U0000026F", 1},
+    {U"\U0000026F\U0000031E", 2},
+    {U"\U00000270", 1},
+    {U"\U00000271", 1},
+    {U"\U00000272", 1},
+    {U"\U00000273", 1},
+    {U"\U00000274", 1},
+    {U"\U00000275", 1},
+    {U"\U00000276", 1},
+    {U"\U00000278", 1},
+    {U"\U00000279", 1},
+    {U"\U0000027A", 1},
+    {U"\U0000027B", 1},
+    {U"\U0000027D", 1},
+    {U"\U0000027E", 1},
+    {U"\U00000280", 1},
+    {U"\U00000281", 1},
+    {U"\U00000282", 1},
+    {U"\U00000283", 1},
+    {U"\U00000284", 1},
+    {U"\U00000288", 1},
+    {U"\U00000289", 1},
+    {U"\U00000289\U0000031E", 2},
+    {U"\U0000028A", 1},
+    {U"\U0000028B", 1},
+    {U"\U0000028C", 1},
+    {U"\U0000028D", 1},
+    {U"\U0000028E", 1},
+    {U"\U0000028F", 1},
+    {U"\U00000290", 1},
+    {U"\U00000291", 1},
+    {U"\U00000292", 1},
+    {U"\U00000294", 1},
+    {U"\U00000295", 1},
+    {U"\U00000298", 1},
+    {U"\U00000299", 1},
+    {U"\U0000029B", 1},
+    {U"\U0000029C", 1},
+    {U"\U0000029D", 1},
+    {U"\U0000029E", 1},
+    {U"\U0000029F", 1},
+    {U"\U000002A1", 1},
+    {U"\U000002A2", 1},
+    {U"\U000002B0", 1},
+    {U"\U000002B1", 1},
+    {U"\U000002B2", 1},
+    {U"\U000002B3", 1},
+    {U"\U000002B4", 1},
+    {U"\U000002B5", 1},
+    {U"\U000002B6", 1},
+    {U"\U000002B7", 1},
+    {U"\U000002B8", 1},
+    {U"\U000002B9", 1},
+    {U"\U000002BA", 1},
+    {U"\U000002C0", 1},
+    {U"\U000002C1", 1},
+    {U"\U000002C8", 1},
+    {U"\U000002D0", 1},
+    {U"\U000003B2", 1},
+    {U"\U000003B8", 1},
+    {U"\U000003C7", 1},
+    {U"\U00001D91", 1},
+    {U"\U00002074", 1},
+    {U"\U00002074\U000000B2", 2},
+    {U"\U00002074\U000000B2\U000000B3", 3},
+    {U"\U00002074\U000000B2\U000000B9", 3},
+    {U"\U00002074\U000000B2\U00002075", 3},
+    {U"\U00002074\U000000B3", 2},
+    {U"\U00002074\U000000B3\U000000B2", 3},
+    {U"\U00002074\U000000B3\U000000B9", 3},
+    {U"\U00002074\U000000B3\U00002075", 3},
+    {U"\U00002074\U000000B9", 2},
+    {U"\U00002074\U000000B9\U000000B2", 3},
+    {U"\U00002074\U000000B9\U000000B3", 3},
+    {U"\U00002074\U000000B9\U00002075", 3},
+    {U"\U00002074\U00002074", 2},
+    {U"\U00002074\U00002075", 2},
+    {U"\U00002074\U00002075\U000000B2", 3},
+    {U"\U00002074\U00002075\U000000B3", 3},
+    {U"\U00002074\U00002075\U000000B9", 3},
+    {U"\U00002075", 1},
+    {U"\U00002075\U000000B2", 2},
+    {U"\U00002075\U000000B2\U000000B3", 3},
+    {U"\U00002075\U000000B2\U000000B9", 3},
+    {U"\U00002075\U000000B2\U00002074", 3},
+    {U"\U00002075\U000000B3", 2},
+    {U"\U00002075\U000000B3\U000000B2", 3},
+    {U"\U00002075\U000000B3\U000000B9", 3},
+    {U"\U00002075\U000000B3\U00002074", 3},
+    {U"\U00002075\U000000B9", 2},
+    {U"\U00002075\U000000B9\U000000B2", 3},
+    {U"\U00002075\U000000B9\U000000B3", 3},
+    {U"\U00002075\U000000B9\U00002074", 3},
+    {U"\U00002075\U00002074", 2},
+    {U"\U00002075\U00002074\U000000B2", 3},
+    {U"\U00002075\U00002074\U000000B3", 3},
+    {U"\U00002075\U00002074\U000000B9", 3},
+    {U"\U00002075\U00002075", 2},
+    {U"\U000025CC\U000002DE", 2},
+    {U"\U000025CC\U00000303", 2},
+    {U"\U000025CC\U00000307", 2},
+    {U"\U000025CC\U00000308", 2},
+    {U"\U000025CC\U0000030A", 2},
+    {U"\U000025CC\U0000030D", 2},
+    {U"\U000025CC\U00000318", 2},
+    {U"\U000025CC\U00000319", 2},
+    {U"\U000025CC\U0000031C", 2},
+    {U"\U000025CC\U0000031D", 2},
+    {U"\U000025CC\U0000031E", 2},
+    {U"\U000025CC\U0000031F", 2},
+    {U"\U000025CC\U00000320", 2},
+    {U"\U000025CC\U00000323", 2},
+    {U"\U000025CC\U00000324", 2},
+    {U"\U000025CC\U00000325", 2},
+    {U"\U000025CC\U00000329", 2},
+    {U"\U000025CC\U0000032A", 2},
+    {U"\U000025CC\U0000032C", 2},
+    {U"\U000025CC\U0000032F", 2},
+    {U"\U000025CC\U00000330", 2},
+    {U"\U000025CC\U00000334", 2},
+    {U"\U000025CC\U00000339", 2},
+    {U"\U000025CC\U0000033A", 2},
+    {U"\U000025CC\U0000033B", 2},
+    {U"\U000025CC\U0000033C", 2},
+    {U"\U000025CC\U0000033D", 2},
+    {U"\U000025CC\U00000351", 2},
+    {U"\U000025CC\U00000353", 2},
+    {U"\U000025CC\U00000357", 2},
+    {U"\U000025CC\U00000361", 2},
+    {U"\U00002C71", 1},
+    {U"\U0000A700", 1},
+    {U"\U0000A701", 1},
+    {U"\U0000A702", 1},
+    {U"\U0000A703", 1},
+    {U"\U0000A704", 1},
+    {U"\U0000A705", 1},
+    {U"\U0000A706", 1},
+    {U"\U0000A707", 1},
+    {U"\U0000A708", 1},
+    {U"\U0000A709", 1},
+    {U"\U0000A70A", 1},
+    {U"\U0000A70B", 1},
+    {U"\U0000A70C", 1},
+    {U"\U0001DF0A", 1},
+};
+
+inline constexpr DictEntry kBuiltinSchemeEntries[] = {
+    {kBuiltinSchemeValues[1], 1, 1, false},
+    {kBuiltinSchemeValues[0], 0, 7, false},
+    {kBuiltinSchemeValues[2], 2, 1, false},
+    {kBuiltinSchemeValues[3], 3, 1, false},
+    {kBuiltinSchemeValues[4], 4, 1, false},
+    {kBuiltinSchemeValues[5], 5, 1, false},
+    {kBuiltinSchemeValues[7], 7, 1, false},
+    {kBuiltinSchemeValues[8], 8, 1, false},
+    {kBuiltinSchemeValues[9], 9, 1, false},
+    {kBuiltinSchemeValues[10], 10, 1, false},
+    {kBuiltinSchemeValues[11], 11, 1, false},
+    {kBuiltinSchemeValues[12], 12, 1, false},
+    {kBuiltinSchemeValues[13], 13, 1, false},
+    {kBuiltinSchemeValues[14], 14, 1, false},
+    {kBuiltinSchemeValues[15], 15, 1, false},
+    {kBuiltinSchemeValues[16], 16, 1, false},
+    {kBuiltinSchemeValues[18], 18, 1, false},
+    {kBuiltinSchemeValues[19], 19, 1, false},
+    {kBuiltinSchemeValues[20], 20, 1, false},
+    {kBuiltinSchemeValues[21], 21, 1, false},
+    {kBuiltinSchemeValues[22], 22, 1, false},
+    {kBuiltinSchemeValues[23], 23, 1, false},
+    {kBuiltinSchemeValues[24], 24, 1, false},
+    {kBuiltinSchemeValues[25], 25, 1, false},
+    {kBuiltinSchemeValues[26], 26, 1, false},
+    {kBuiltinSchemeValues[27], 27, 1, false},
+    {kBuiltinSchemeValues[226], 226, 2, false},
+    {kBuiltinSchemeValues[247], 247, 2, false},
+    {kBuiltinSchemeValues[242], 242, 2, false},
+    {kBuiltinSchemeValues[237], 237, 2, false},
+    {kBuiltinSchemeValues[238], 238, 2, false},
+    {kBuiltinSchemeValues[239], 239, 2, false},
+    {kBuiltinSchemeValues[240], 240, 2, false},
+    {kBuiltinSchemeValues[250], 250, 2, false},
+    {kBuiltinSchemeValues[237], 237, 2, false},
+    {kBuiltinSchemeValues[237], 237, 2, false},
+    {kBuiltinSchemeValues[232], 232, 2, false},
+    {kBuiltinSchemeValues[234], 234, 2, false},
+    {kBuiltinSchemeValues[251], 251, 2, false},
+    {kBuiltinSchemeValues[248], 248, 2, false},
+    {kBuiltinSchemeValues[243], 243, 2, false},
+    {kBuiltinSchemeValues[245], 245, 2, false},
+    {kBuiltinSchemeValues[241], 241, 2, false},
+    {kBuiltinSchemeValues[236], 236, 2, false},
+    {kBuiltinSchemeValues[233], 233, 2, false},
+    {kBuiltinSchemeValues[235], 235, 2, false},
+    {kBuiltinSchemeValues[249], 249, 2, false},
+    {kBuiltinSchemeValues[244], 244, 2, false},
+    {kBuiltinSchemeValues[254], 254, 2, false},
+    {kBuiltinSchemeValues[246], 246, 2, false},
+    {kBuiltinSchemeValues[171], 171, 1, false},
+    {kBuiltinSchemeValues[185], 185, 1, false},
+    {kBuiltinSchemeValues[184], 184, 1, false},
+    {kBuiltinSchemeValues[181], 181, 1, false},
+    {kBuiltinSchemeValues[180], 180, 1, false},
+    {kBuiltinSchemeValues[64], 64, 1, false},
+    {kBuiltinSchemeValues[73], 73, 2, false},
+    {kBuiltinSchemeValues[65], 65, 2, false},
+    {kBuiltinSchemeValues[66], 66, 3, false},
+    {kBuiltinSchemeValues[67], 67, 3, false},
+    {kBuiltinSchemeValues[68], 68, 3, false},
+    {kBuiltinSchemeValues[69], 69, 2, false},
+    {kBuiltinSchemeValues[70], 70, 3, false},
+    {kBuiltinSchemeValues[71], 71, 3, false},
+    {kBuiltinSchemeValues[72], 72, 3, false},
+    {kBuiltinSchemeValues[74], 74, 2, false},
+    {kBuiltinSchemeValues[75], 75, 3, false},
+    {kBuiltinSchemeValues[76], 76, 3, false},
+    {kBuiltinSchemeValues[77], 77, 3, false},
+    {kBuiltinSchemeValues[78], 78, 2, false},
+    {kBuiltinSchemeValues[79], 79, 3, false},
+    {kBuiltinSchemeValues[80], 80, 3, false},
+    {kBuiltinSchemeValues[81], 81, 3, false},
+    {kBuiltinSchemeValues[28], 28, 1, false},
+    {kBuiltinSchemeValues[34], 34, 2, false},
+    {kBuiltinSchemeValues[35], 35, 3, false},
+    {kBuiltinSchemeValues[36], 36, 3, false},
+    {kBuiltinSchemeValues[37], 37, 3, false},
+    {kBuiltinSchemeValues[29], 29, 2, false},
+    {kBuiltinSchemeValues[30], 30, 2, false},
+    {kBuiltinSchemeValues[31], 31, 3, false},
+    {kBuiltinSchemeValues[32], 32, 3, false},
+    {kBuiltinSchemeValues[33], 33, 3, false},
+    {kBuiltinSchemeValues[38], 38, 2, false},
+    {kBuiltinSchemeValues[40], 40, 3, false},
+    {kBuiltinSchemeValues[39], 39, 3, false},
+    {kBuiltinSchemeValues[41], 41, 3, false},
+    {kBuiltinSchemeValues[42], 42, 2, false},
+    {kBuiltinSchemeValues[44], 44, 3, false},
+    {kBuiltinSchemeValues[43], 43, 3, false},
+    {kBuiltinSchemeValues[45], 45, 3, false},
+    {kBuiltinSchemeValues[46], 46, 1, false},
+    {kBuiltinSchemeValues[52], 52, 2, false},
+    {kBuiltinSchemeValues[53], 53, 3, false},
+    {kBuiltinSchemeValues[54], 54, 3, false},
+    {kBuiltinSchemeValues[55], 55, 3, false},
+    {kBuiltinSchemeValues[47], 47, 2, false},
+    {kBuiltinSchemeValues[48], 48, 3, false},
+    {kBuiltinSchemeValues[49], 49, 3, false},
+    {kBuiltinSchemeValues[50], 50, 3, false},
+    {kBuiltinSchemeValues[51], 51, 2, false},
+    {kBuiltinSchemeValues[56], 56, 2, false},
+    {kBuiltinSchemeValues[58], 58, 3, false},
+    {kBuiltinSchemeValues[57], 57, 3, false},
+    {kBuiltinSchemeValues[59], 59, 3, false},
+    {kBuiltinSchemeValues[60], 60, 2, false},
+    {kBuiltinSchemeValues[62], 62, 3, false},
+    {kBuiltinSchemeValues[61], 61, 3, false},
+    {kBuiltinSchemeValues[63], 63, 3, false},
+    {kBuiltinSchemeValues[190], 190, 1, false},
+    {kBuiltinSchemeValues[199], 199, 2, false},
+    {kBuiltinSchemeValues[200], 200, 3, false},
+    {kBuiltinSchemeValues[201], 201, 3, false},
+    {kBuiltinSchemeValues[202], 202, 3, false},
+    {kBuiltinSchemeValues[191], 191, 2, false},
+    {kBuiltinSchemeValues[193], 193, 3, false},
+    {kBuiltinSchemeValues[192], 192, 3, false},
+    {kBuiltinSchemeValues[194], 194, 3, false},
+    {kBuiltinSchemeValues[195], 195, 2, false},
+    {kBuiltinSchemeValues[197], 197, 3, false},
+    {kBuiltinSchemeValues[196], 196, 3, false},
+    {kBuiltinSchemeValues[198], 198, 3, false},
+    {kBuiltinSchemeValues[203], 203, 2, false},
+    {kBuiltinSchemeValues[204], 204, 2, false},
+    {kBuiltinSchemeValues[207], 207, 3, false},
+    {kBuiltinSchemeValues[205], 205, 3, false},
+    {kBuiltinSchemeValues[206], 206, 3, false},
+    {kBuiltinSchemeValues[208], 208, 1, false},
+    {kBuiltinSchemeValues[217], 217, 2, false},
+    {kBuiltinSchemeValues[218], 218, 3, false},
+    {kBuiltinSchemeValues[219], 219, 3, false},
+    {kBuiltinSchemeValues[220], 220, 3, false},
+    {kBuiltinSchemeValues[209], 209, 2, false},
+    {kBuiltinSchemeValues[211], 211, 3, false},
+    {kBuiltinSchemeValues[210], 210, 3, false},
+    {kBuiltinSchemeValues[212], 212, 3, false},
+    {kBuiltinSchemeValues[213], 213, 2, false},
+    {kBuiltinSchemeValues[215], 215, 3, false},
+    {kBuiltinSchemeValues[214], 214, 3, false},
+    {kBuiltinSchemeValues[216], 216, 3, false},
+    {kBuiltinSchemeValues[221], 221, 2, false},
+    {kBuiltinSchemeValues[224], 224, 3, false},
+    {kBuiltinSchemeValues[222], 222, 3, false},
+    {kBuiltinSchemeValues[223], 223, 3, false},
+    {kBuiltinSchemeValues[225], 225, 2, false},
+    {kBuiltinSchemeValues[171], 171, 1, false},
+    {kBuiltinSchemeValues[182], 182, 1, false},
+    {kBuiltinSchemeValues[183], 183, 1, false},
+    {kBuiltinSchemeValues[182], 182, 1, false},
+    {kBuiltinSchemeValues[183], 183, 1, false},
+    {kBuiltinSchemeValues[172], 172, 1, false},
+    {kBuiltinSchemeValues[173], 173, 1, false},
+    {kBuiltinSchemeValues[174], 174, 1, false},
+    {kBuiltinSchemeValues[175], 175, 1, false},
+    {kBuiltinSchemeValues[177], 177, 1, false},
+    {kBuiltinSchemeValues[176], 176, 1, false},
+    {kBuiltinSchemeValues[178], 178, 1, false},
+    {kBuiltinSchemeValues[179], 179, 1, false},
+    {kBuiltinSchemeValues[231], 231, 2, false},
+    {kBuiltinSchemeValues[228], 228, 2, false},
+    {kBuiltinSchemeValues[229], 229, 2, false},
+    {kBuiltinSchemeValues[253], 253, 2, false},
+    {kBuiltinSchemeValues[255], 255, 2, false},
+    {kBuiltinSchemeValues[227], 227, 2, false},
+    {kBuiltinSchemeValues[230], 230, 2, false},
+    {kBuiltinSchemeValues[252], 252, 2, false},
+    {kBuiltinSchemeValues[227], 227, 2, false},
+    {kBuiltinSchemeValues[226], 226, 2, false},
+    {kBuiltinSchemeValues[270], 270, 1, false},
+    {kBuiltinSchemeValues[269], 269, 1, false},
+    {kBuiltinSchemeValues[268], 268, 1, false},
+    {kBuiltinSchemeValues[267], 267, 1, false},
+    {kBuiltinSchemeValues[266], 266, 1, false},
+    {kBuiltinSchemeValues[256], 256, 2, false},
+    {kBuiltinSchemeValues[259], 259, 1, false},
+    {kBuiltinSchemeValues[263], 263, 1, false},
+    {kBuiltinSchemeValues[265], 265, 1, false},
+    {kBuiltinSchemeValues[261], 261, 1, false},
+    {kBuiltinSchemeValues[258], 258, 1, false},
+    {kBuiltinSchemeValues[262], 262, 1, false},
+    {kBuiltinSchemeValues[264], 264, 1, false},
+    {kBuiltinSchemeValues[260], 260, 1, false},
+    {kBuiltinSchemeValues[82], 82, 1, false},
+    {kBuiltinSchemeValues[99], 99, 1, false},
+    {kBuiltinSchemeValues[82], 82, 1, false},
+    {kBuiltinSchemeValues[83], 83, 1, false},
+    {kBuiltinSchemeValues[98], 98, 1, false},
+    {kBuiltinSchemeValues[102], 102, 1, false},
+    {kBuiltinSchemeValues[163], 163, 1, false},
+    {kBuiltinSchemeValues[186], 186, 1, false},
+    {kBuiltinSchemeValues[93], 93, 1, false},
+    {kBuiltinSchemeValues[147], 147, 1, false},
+    {kBuiltinSchemeValues[84], 84, 1, false},
+    {kBuiltinSchemeValues[132], 132, 1, false},
+    {kBuiltinSchemeValues[84], 84, 1, false},
+    {kBuiltinSchemeValues[104], 104, 1, false},
+    {kBuiltinSchemeValues[112], 112, 1, false},
+    {kBuiltinSchemeValues[147], 147, 1, false},
+    {kBuiltinSchemeValues[106], 106, 1, false},
+    {kBuiltinSchemeValues[85], 85, 1, false},
+    {kBuiltinSchemeValues[105], 105, 1, false},
+    {kBuiltinSchemeValues[189], 189, 1, false},
+    {kBuiltinSchemeValues[95], 95, 1, false},
+    {kBuiltinSchemeValues[6], 6, 2, false},
+    {kBuiltinSchemeValues[109], 109, 1, false},
+    {kBuiltinSchemeValues[153], 153, 1, false},
+    {kBuiltinSchemeValues[110], 110, 1, false},
+    {kBuiltinSchemeValues[116], 116, 1, false},
+    {kBuiltinSchemeValues[117], 117, 2, false},
+    {kBuiltinSchemeValues[107], 107, 1, false},
+    {kBuiltinSchemeValues[108], 108, 1, false},
+    {kBuiltinSchemeValues[122], 122, 1, false},
+    {kBuiltinSchemeValues[86], 86, 1, false},
+    {kBuiltinSchemeValues[87], 87, 2, false},
+    {kBuiltinSchemeValues[135], 135, 1, false},
+    {kBuiltinSchemeValues[156], 156, 1, false},
+    {kBuiltinSchemeValues[137], 137, 1, false},
+    {kBuiltinSchemeValues[113], 113, 1, false},
+    {kBuiltinSchemeValues[89], 89, 1, false},
+    {kBuiltinSchemeValues[115], 115, 1, false},
+    {kBuiltinSchemeValues[160], 160, 1, false},
+    {kBuiltinSchemeValues[161], 161, 1, false},
+    {kBuiltinSchemeValues[88], 88, 1, false},
+    {kBuiltinSchemeValues[161], 161, 1, false},
+    {kBuiltinSchemeValues[169], 169, 1, false},
+    {kBuiltinSchemeValues[170], 170, 1, false},
+    {kBuiltinSchemeValues[119], 119, 1, false},
+    {kBuiltinSchemeValues[169], 169, 1, false},
+    {kBuiltinSchemeValues[88], 88, 1, false},
+    {kBuiltinSchemeValues[161], 161, 1, false},
+    {kBuiltinSchemeValues[160], 160, 1, false},
+    {kBuiltinSchemeValues[161], 161, 1, false},
+    {kBuiltinSchemeValues[165], 165, 1, false},
+    {kBuiltinSchemeValues[170], 170, 1, false},
+    {kBuiltinSchemeValues[119], 119, 1, false},
+    {kBuiltinSchemeValues[128], 128, 1, false},
+    {kBuiltinSchemeValues[129], 129, 2, false},
+    {kBuiltinSchemeValues[120], 120, 1, false},
+    {kBuiltinSchemeValues[121], 121, 2, false},
+    {kBuiltinSchemeValues[166], 166, 1, false},
+    {kBuiltinSchemeValues[118], 118, 1, false},
+    {kBuiltinSchemeValues[155], 155, 1, false},
+    {kBuiltinSchemeValues[155], 155, 1, false},
+    {kBuiltinSchemeValues[166], 166, 1, false},
+    {kBuiltinSchemeValues[118], 118, 1, false},
+    {kBuiltinSchemeValues[123], 123, 1, false},
+    {kBuiltinSchemeValues[92], 92, 1, false},
+    {kBuiltinSchemeValues[155], 155, 1, false},
+    {kBuiltinSchemeValues[139], 139, 1, false},
+    {kBuiltinSchemeValues[125], 125, 1, false},
+    {kBuiltinSchemeValues[126], 126, 2, false},
+    {kBuiltinSchemeValues[124], 124, 1, false},
+    {kBuiltinSchemeValues[168], 168, 1, false},
+    {kBuiltinSchemeValues[127], 127, 1, false},
+    {kBuiltinSchemeValues[131], 131, 1, false},
+    {kBuiltinSchemeValues[131], 131, 1, false},
+    {kBuiltinSchemeValues[133], 133, 1, false},
+    {kBuiltinSchemeValues[96], 96, 1, false},
+    {kBuiltinSchemeValues[17], 17, 2, false},
+    {kBuiltinSchemeValues[136], 136, 1, false},
+    {kBuiltinSchemeValues[101], 101, 2, false},
+    {kBuiltinSchemeValues[100], 100, 1, false},
+    {kBuiltinSchemeValues[101], 101, 2, false},
+    {kBuiltinSchemeValues[100], 100, 1, false},
+    {kBuiltinSchemeValues[90], 90, 1, false},
+    {kBuiltinSchemeValues[86], 86, 1, false},
+    {kBuiltinSchemeValues[90], 90, 1, false},
+    {kBuiltinSchemeValues[111], 111, 1, false},
+    {kBuiltinSchemeValues[111], 111, 1, false},
+    {kBuiltinSchemeValues[135], 135, 1, false},
+    {kBuiltinSchemeValues[103], 103, 1, false},
+    {kBuiltinSchemeValues[162], 162, 1, false},
+    {kBuiltinSchemeValues[164], 164, 1, false},
+    {kBuiltinSchemeValues[114], 114, 1, false},
+    {kBuiltinSchemeValues[134], 134, 1, false},
+    {kBuiltinSchemeValues[143], 143, 1, false},
+    {kBuiltinSchemeValues[188], 188, 1, false},
+    {kBuiltinSchemeValues[144], 144, 1, false},
+    {kBuiltinSchemeValues[114], 114, 1, false},
+    {kBuiltinSchemeValues[164], 164, 1, false},
+    {kBuiltinSchemeValues[138], 138, 1, false},
+    {kBuiltinSchemeValues[142], 142, 1, false},
+    {kBuiltinSchemeValues[141], 141, 1, false},
+    {kBuiltinSchemeValues[144], 144, 1, false},
+    {kBuiltinSchemeValues[108], 108, 1, false},
+    {kBuiltinSchemeValues[146], 146, 1, false},
+    {kBuiltinSchemeValues[145], 145, 1, false},
+    {kBuiltinSchemeValues[140], 140, 1, false},
+    {kBuiltinSchemeValues[141], 141, 1, false},
+    {kBuiltinSchemeValues[104], 104, 1, false},
+    {kBuiltinSchemeValues[94], 94, 1, false},
+    {kBuiltinSchemeValues[187], 187, 1, false},
+    {kBuiltinSchemeValues[91], 91, 1, false},
+    {kBuiltinSchemeValues[148], 148, 1, false},
+    {kBuiltinSchemeValues[271], 271, 1, false},
+    {kBuiltinSchemeValues[133], 133, 1, false},
+    {kBuiltinSchemeValues[97], 97, 1, false},
+    {kBuiltinSchemeValues[128], 128, 1, false},
+    {kBuiltinSchemeValues[151], 151, 1, false},
+    {kBuiltinSchemeValues[129], 129, 2, false},
+    {kBuiltinSchemeValues[149], 149, 1, false},
+    {kBuiltinSchemeValues[150], 150, 2, false},
+    {kBuiltinSchemeValues[154], 154, 1, false},
+    {kBuiltinSchemeValues[152], 152, 1, false},
+    {kBuiltinSchemeValues[257], 257, 1, false},
+    {kBuiltinSchemeValues[186], 186, 1, false},
+    {kBuiltinSchemeValues[130], 130, 1, false},
+    {kBuiltinSchemeValues[168], 168, 1, false},
+    {kBuiltinSchemeValues[167], 167, 1, false},
+    {kBuiltinSchemeValues[115], 115, 1, false},
+    {kBuiltinSchemeValues[159], 159, 1, false},
+    {kBuiltinSchemeValues[157], 157, 1, false},
+    {kBuiltinSchemeValues[158], 158, 1, false},
+    {kBuiltinSchemeValues[227], 227, 2, false},
+};
+
+inline constexpr StaticSchemes::Key kBuiltinSchemeKeys[] = {
+    {{"//a", 3}, 1, 0, 1, 0},
+    {{"//after", 7}, 1, 1, 1, 0},
+    {{"//b", 3}, 1, 2, 1, 0},
+    {{"//c", 3}, 1, 3, 1, 0},
+    {{"//d", 3}, 1, 4, 1, 0},
+    {{"//e", 3}, 1, 5, 1, 0},
+    {{"//f", 3}, 1, 6, 1, 0},
+    {{"//g", 3}, 1, 7, 1, 0},
+    {{"//h", 3}, 1, 8, 1, 0},
+    {{"//i", 3}, 1, 9, 1, 0},
+    {{"//j", 3}, 1, 10, 1, 0},
+    {{"//k", 3}, 1, 11, 1, 0},
+    {{"//l", 3}, 1, 12, 1, 0},
+    {{"//m", 3}, 1, 13, 1, 0},
+    {{"//n", 3}, 1, 14, 1, 0},
+    {{"//o", 3}, 1, 15, 1, 0},
+    {{"//p", 3}, 1, 16, 1, 0},
+    {{"//q", 3}, 1, 17, 1, 0},
+    {{"//r", 3}, 1, 18, 1, 0},
+    {{"//s", 3}, 1, 19, 1, 0},
+    {{"//t", 3}, 1, 20, 1, 0},
+    {{"//u", 3}, 1, 21, 1, 0},
+    {{"//v", 3}, 1, 22, 1, 0},
+    {{"//x", 3}, 1, 23, 1, 0},
+    {{"//y", 3}, 1, 24, 1, 0},
+    {{"//z", 3}, 1, 25, 1, 0},
+    {{"Br", 2}, 1, 26, 1, 0},
+    {{"B~", 2}, 1, 27, 1, 0},
+    {{"D", 1}, 1, 28, 1, 0},
+    {{"D+", 2}, 1, 29, 1, 0},
+    {{"D-", 2}, 1, 30, 1, 0},
+    {{"D.", 2}, 1, 31, 1, 0},
+    {{"D..", 3}, 1, 32, 1, 0},
+    {{"Da", 2}, 1, 33, 1, 0},
+    {{"Dchr", 4}, 1, 34, 1, 0},
+    {{"Dhr", 3}, 1, 35, 1, 0},
+    {{"Dl", 2}, 1, 36, 1, 0},
+    {{"Dlr", 3}, 1, 37, 1, 0},
+    {{"Dm", 2}, 1, 38, 1, 0},
+    {{"Dmr", 3}, 1, 39, 1, 0},
+    {{"Dn", 2}, 1, 40, 1, 0},
+    {{"Dnn", 3}, 1, 41, 1, 0},
+    {{"Do", 2}, 1, 42, 1, 0},
+    {{"Dp", 2}, 1, 43, 1, 0},
+    {{"Dr", 2}, 1, 44, 1, 0},
+    {{"Dt", 2}, 1, 45, 1, 0},
+    {{"Du", 2}, 1, 46, 1, 0},
+    {{"Dv", 2}, 1, 47, 1, 0},
+    {{"Dx", 2}, 1, 48, 1, 0},
+    {{"D~", 2}, 1, 49, 1, 0},
+    {{"H", 1}, 0, 50, 1, 0},
+    {{"L", 1}, 1, 51, 1, 0},
+    {{"P'", 2}, 1, 52, 1, 0},
+    {{"P''", 3}, 1, 53, 1, 0},
+    {{"P'13", 4}, 1, 54, 1, 0},
+    {{"P1", 2}, 3, 55, 1, 0},
+    {{"P11", 3}, 3, 56, 1, 0},
+    {{"P12", 3}, 3, 57, 1, 0},
+    {{"P123", 4}, 3, 58, 1, 0},
+    {{"P124", 4}, 3, 59, 1, 0},
+    {{"P125", 4}, 3, 60, 1, 0},
+    {{"P13", 3}, 3, 61, 1, 0},
+    {{"P132", 4}, 3, 62, 1, 0},
+    {{"P134", 4}, 3, 63, 1, 0},
+    {{"P135", 4}, 3, 64, 1, 0},
+    {{"P14", 3}, 3, 65, 1, 0},
+    {{"P142", 4}, 3, 66, 1, 0},
+    {{"P143", 4}, 3, 67, 1, 0},
+    {{"P145", 4}, 3, 68, 1, 0},
+    {{"P15", 3}, 3, 69, 1, 0},
+    {{"P152", 4}, 3, 70, 1, 0},
+    {{"P153", 4}, 3, 71, 1, 0},
+    {{"P154", 4}, 3, 72, 1, 0},
+    {{"P2", 2}, 3, 73, 1, 0},
+    {{"P21", 3}, 3, 74, 1, 0},
+    {{"P213", 4}, 3, 75, 1, 0},
+    {{"P214", 4}, 3, 76, 1, 0},
+    {{"P215", 4}, 3, 77, 1, 0},
+    {{"P22", 3}, 3, 78, 1, 0},
+    {{"P23", 3}, 3, 79, 1, 0},
+    {{"P231", 4}, 3, 80, 1, 0},
+    {{"P234", 4}, 3, 81, 1, 0},
+    {{"P235", 4}, 3, 82, 1, 0},
+    {{"P24", 3}, 3, 83, 1, 0},
+    {{"P241", 4}, 3, 84, 1, 0},
+    {{"P243", 4}, 3, 85, 1, 0},
+    {{"P245", 4}, 3, 86, 1, 0},
+    {{"P25", 3}, 3, 87, 1, 0},
+    {{"P251", 4}, 3, 88, 1, 0},
+    {{"P253", 4}, 3, 89, 1, 0},
+    {{"P254", 4}, 3, 90, 1, 0},
+    {{"P3", 2}, 3, 91, 1, 0},
+    {{"P31", 3}, 3, 92, 1, 0},
+    {{"P312", 4}, 3, 93, 1, 0},
+    {{"P314", 4}, 3, 94, 1, 0},
+    {{"P315", 4}, 3, 95, 1, 0},
+    {{"P32", 3}, 3, 96, 1, 0},
+    {{"P321", 4}, 3, 97, 1, 0},
+    {{"P324", 4}, 3, 98, 1, 0},
+    {{"P325", 4}, 3, 99, 1, 0},
+    {{"P33", 3}, 3, 100, 1, 0},
+    {{"P34", 3}, 3, 101, 1, 0},
+    {{"P341", 4}, 3, 102, 1, 0},
+    {{"P342", 4}, 3, 103, 1, 0},
+    {{"P345", 4}, 3, 104, 1, 0},
+    {{"P35", 3}, 3, 105, 1, 0},
+    {{"P351", 4}, 3, 106, 1, 0},
+    {{"P352", 4}, 3, 107, 1, 0},
+    {{"P354", 4}, 3, 108, 1, 0},
+    {{"P4", 2}, 3, 109, 1, 0},
+    {{"P41", 3}, 3, 110, 1, 0},
+    {{"P412", 4}, 3, 111, 1, 0},
+    {{"P413", 4}, 3, 112, 1, 0},
+    {{"P415", 4}, 3, 113, 1, 0},
+    {{"P42", 3}, 3, 114, 1, 0},
+    {{"P421", 4}, 3, 115, 1, 0},
+    {{"P423", 4}, 3, 116, 1, 0},
+    {{"P425", 4}, 3, 117, 1, 0},
+    {{"P43", 3}, 3, 118, 1, 0},
+    {{"P431", 4}, 3, 119, 1, 0},
+    {{"P432", 4}, 3, 120, 1, 0},
+    {{"P435", 4}, 3, 121, 1, 0},
+    {{"P44", 3}, 3, 122, 1, 0},
+    {{"P45", 3}, 3, 123, 1, 0},
+    {{"P451", 4}, 3, 124, 1, 0},
+    {{"P452", 4}, 3, 125, 1, 0},
+    {{"P453", 4}, 3, 126, 1, 0},
+    {{"P5", 2}, 3, 127, 1, 0},
+    {{"P51", 3}, 3, 128, 1, 0},
+    {{"P512", 4}, 3, 129, 1, 0},
+    {{"P513", 4}, 3, 130, 1, 0},
+    {{"P514", 4}, 3, 131, 1, 0},
+    {{"P52", 3}, 3, 132, 1, 0},
+    {{"P521", 4}, 3, 133, 1, 0},
+    {{"P523", 4}, 3, 134, 1, 0},
+    {{"P524", 4}, 3, 135, 1, 0},
+    {{"P53", 3}, 3, 136, 1, 0},
+    {{"P531", 4}, 3, 137, 1, 0},
+    {{"P532", 4}, 3, 138, 1, 0},
+    {{"P534", 4}, 3, 139, 1, 0},
+    {{"P54", 3}, 3, 140, 1, 0},
+    {{"P541", 4}, 3, 141, 1, 0},
+    {{"P542", 4}, 3, 142, 1, 0},
+    {{"P543", 4}, 3, 143, 1, 0},
+    {{"P55", 3}, 3, 144, 1, 0},
+    {{"Ph", 2}, 1, 145, 1, 0},
+    {{"Ph1", 3}, 1, 146, 1, 0},
+    {{"Ph2", 3}, 1, 147, 1, 0},
+    {{"Phq", 3}, 1, 148, 1, 0},
+    {{"Phqx", 4}, 1, 149, 1, 0},
+    {{"Phz", 3}, 1, 150, 1, 0},
+    {{"Pj", 2}, 1, 151, 1, 0},
+    {{"Pr", 2}, 1, 152, 1, 0},
+    {{"Prh", 3}, 1, 153, 1, 0},
+    {{"Prx\357\274\214Pqxz", 10}, 1, 154, 1, 0},
+    {{"Psrh", 4}, 1, 155, 1, 0},
+    {{"Pw", 2}, 1, 156, 1, 0},
+    {{"Py", 2}, 1, 157, 1, 0},
+    {{"Q", 1}, 1, 158, 1, 0},
+    {{"Q.", 2}, 1, 159, 1, 0},
+    {{"Q..", 3}, 1, 160, 1, 0},
+    {{"Qlr", 3}, 1, 161, 1, 0},
+    {{"Qmr", 3}, 1, 162, 1, 0},
+    {{"Qnn", 3}, 1, 163, 1, 0},
+    {{"Qo", 2}, 1, 164, 1, 0},
+    {{"Qx", 2}, 1, 165, 1, 0},
+    {{"Q~", 2}, 1, 166, 1, 0},
+    {{"R", 1}, 0, 167, 1, 0},
+    {{"T1T", 3}, 3, 168, 1, 1},
+    {{"T2T", 3}, 3, 169, 1, 1},
+    {{"T3T", 3}, 3, 170, 1, 1},
+    {{"T4T", 3}, 3, 171, 1, 1},
+    {{"T5T", 3}, 3, 172, 1, 1},
+    {{"W", 1}, 1, 173, 1, 0},
+    {{"YaP", 3}, 3, 174, 1, 0},
+    {{"YaQ", 3}, 3, 175, 1, 0},
+    {{"YaR", 3}, 3, 176, 1, 0},
+    {{"YaS", 3}, 3, 177, 1, 0},
+    {{"YiP", 3}, 3, 178, 1, 0},
+    {{"YiQ", 3}, 3, 179, 1, 0},
+    {{"YiR", 3}, 3, 180, 1, 0},
+    {{"YiS", 3}, 3, 181, 1, 0},
+    {{"aQ..", 4}, 1, 182, 1, 0},
+    {{"ab", 2}, 1, 183, 1, 0},
+    {{"ac", 2}, 1, 184, 1, 0},
+    {{"ae", 2}, 1, 185, 1, 0},
+    {{"aec", 3}, 1, 186, 1, 0},
+    {{"bM", 2}, 1, 187, 1, 0},
+    {{"bv", 2}, 1, 188, 1, 0},
+    {{"bw", 2}, 1, 189, 1, 0},
+    {{"cC", 2}, 1, 190, 1, 0},
+    {{"cM", 2}, 1, 191, 1, 0},
+    {{"cc", 2}, 1, 192, 1, 0},
+    {{"cn", 2}, 1, 193, 1, 0},
+    {{"cs", 2}, 1, 194, 1, 0},
+    {{"cx", 2}, 1, 195, 1, 0},
+    {{"cz", 2}, 1, 196, 1, 0},
+    {{"czM", 3}, 1, 197, 1, 0},
+    {{"dM", 2}, 1, 198, 1, 0},
+    {{"dd", 2}, 1, 199, 1, 0},
+    {{"dr", 2}, 1, 200, 1, 0},
+    {{"drM", 3}, 1, 201, 1, 0},
+    {{"dx", 2}, 1, 202, 1, 0},
+    {{"eDp", 3}, 1, 203, 1, 0},
+    {{"ea", 2}, 1, 204, 1, 0},
+    {{"eab", 3}, 1, 205, 1, 0},
+    {{"eac", 3}, 1, 206, 1, 0},
+    {{"eb", 2}, 1, 207, 1, 0},
+    {{"ebDp", 4}, 1, 208, 1, 0},
+    {{"ec", 2}, 1, 209, 1, 0},
+    {{"ee", 2}, 1, 210, 1, 0},
+    {{"ei", 2}, 1, 211, 1, 0},
+    {{"eo", 2}, 1, 212, 1, 0},
+    {{"eoDp", 4}, 1, 213, 1, 0},
+    {{"eoc", 3}, 1, 214, 1, 0},
+    {{"ey", 2}, 1, 215, 1, 0},
+    {{"fw", 2}, 1, 216, 1, 0},
+    {{"gM", 2}, 1, 217, 1, 0},
+    {{"gn", 2}, 1, 218, 1, 0},
+    {{"gx", 2}, 1, 219, 1, 0},
+    {{"h1", 2}, 1, 220, 1, 0},
+    {{"h2", 2}, 1, 221, 1, 0},
+    {{"h2p", 3}, 1, 222, 1, 0},
+    {{"h2pz", 4}, 1, 223, 1, 0},
+    {{"h3", 2}, 1, 224, 1, 0},
+    {{"h4", 2}, 1, 225, 1, 0},
+    {{"hc", 2}, 1, 226, 1, 0},
+    {{"hk", 2}, 1, 227, 1, 0},
+    {{"hkx", 3}, 1, 228, 1, 0},
+    {{"hkxz", 4}, 1, 229, 1, 0},
+    {{"hq", 2}, 1, 230, 1, 0},
+    {{"hqx", 3}, 1, 231, 1, 0},
+    {{"hr", 2}, 1, 232, 1, 0},
+    {{"hrz", 3}, 1, 233, 1, 0},
+    {{"hz", 2}, 1, 234, 1, 0},
+    {{"ib", 2}, 1, 235, 1, 0},
+    {{"ibDp", 4}, 1, 236, 1, 0},
+    {{"ic", 2}, 1, 237, 1, 0},
+    {{"icDp", 4}, 1, 238, 1, 0},
+    {{"jc", 2}, 1, 239, 1, 0},
+    {{"jh", 2}, 1, 240, 2, 0},
+    {{"jl", 2}, 1, 242, 1, 0},
+    {{"jx", 2}, 1, 243, 1, 0},
+    {{"jy", 2}, 1, 244, 1, 0},
+    {{"lB~", 3}, 1, 245, 1, 0},
+    {{"lC", 2}, 1, 246, 1, 0},
+    {{"lj", 2}, 1, 247, 1, 0},
+    {{"ll", 2}, 1, 248, 1, 0},
+    {{"lr", 2}, 1, 249, 1, 0},
+    {{"lrl", 3}, 1, 250, 1, 0},
+    {{"ls", 2}, 1, 251, 1, 0},
+    {{"lwh", 3}, 1, 252, 1, 0},
+    {{"lz", 2}, 1, 253, 1, 0},
+    {{"mng", 3}, 2, 254, 1, 0},
+    {{"mv", 2}, 1, 255, 1, 0},
+    {{"nh", 2}, 2, 256, 1, 0},
+    {{"nx", 2}, 1, 257, 1, 0},
+    {{"oDp", 3}, 1, 258, 1, 0},
+    {{"oa", 2}, 1, 259, 1, 0},
+    {{"oaQ..", 5}, 1, 260, 1, 0},
+    {{"oab", 3}, 1, 261, 1, 0},
+    {{"oac", 3}, 1, 262, 1, 0},
+    {{"ob", 2}, 1, 263, 1, 0},
+    {{"oe", 2}, 1, 264, 2, 0},
+    {{"oea", 3}, 1, 266, 1, 0},
+    {{"oeac", 4}, 1, 267, 1, 0},
+    {{"oec", 3}, 1, 268, 2, 0},
+    {{"oo", 2}, 1, 270, 1, 0},
+    {{"pC", 2}, 1, 271, 1, 0},
+    {{"qM", 2}, 1, 272, 1, 0},
+    {{"qg", 2}, 1, 273, 1, 0},
+    {{"qn", 2}, 1, 274, 1, 0},
+    {{"qr", 2}, 1, 275, 1, 0},
+    {{"qx", 2}, 1, 276, 1, 0},
+    {{"qxz", 3}, 1, 277, 1, 0},
+    {{"qz", 2}, 1, 278, 1, 0},
+    {{"qzM", 3}, 1, 279, 1, 0},
+    {{"rh", 2}, 1, 280, 1, 0},
+    {{"rl", 2}, 1, 281, 1, 0},
+    {{"rr", 2}, 1, 282, 1, 0},
+    {{"rx", 2}, 1, 283, 1, 0},
+    {{"schwa", 5}, 1, 284, 1, 0},
+    {{"sh", 2}, 1, 285, 1, 0},
+    {{"sr", 2}, 1, 286, 1, 0},
+    {{"srh", 3}, 1, 287, 1, 0},
+    {{"srl", 3}, 1, 288, 1, 0},
+    {{"sx", 2}, 1, 289, 1, 0},
+    {{"tC", 2}, 1, 290, 1, 0},
+    {{"td", 2}, 1, 291, 1, 0},
+    {{"tdC", 3}, 1, 292, 1, 0},
+    {{"tr", 2}, 1, 293, 1, 0},
+    {{"trC", 3}, 1, 294, 1, 0},
+    {{"trn", 3}, 1, 295, 1, 0},
+    {{"tx", 2}, 1, 296, 1, 0},
+    {{"ub", 2}, 1, 297, 2, 0},
+    {{"ubDp", 4}, 1, 299, 1, 0},
+    {{"uc", 2}, 1, 300, 1, 0},
+    {{"ucDp", 4}, 1, 301, 1, 0},
+    {{"uw", 2}, 1, 302, 1, 0},
+    {{"vh", 2}, 1, 303, 1, 0},
+    {{"vl", 2}, 1, 304, 1, 0},
+    {{"vw", 2}, 1, 305, 1, 0},
+    {{"wh", 2}, 1, 306, 1, 0},
+    {{"whl", 3}, 1, 307, 1, 0},
+    {{"xC", 2}, 1, 308, 1, 0},
+    {{"xz", 2}, 1, 309, 1, 0},
+    {{"zh", 2}, 1, 310, 1, 0},
+    {{"zr", 2}, 1, 311, 1, 0},
+    {{"zx", 2}, 1, 312, 1, 0},
+    {{"~", 1}, 0, 313, 1, 0},
+};
+
+inline constexpr StaticSchemes::Node kBuiltinSchemeNodes[] = {
+    {0x5c819a0000000000ull, 0xf, StaticSchemes::kNoNode, 0, 0, 0}, {0x68a54fcea728d36full, 0x2, 365, 155, 1, 104},
+    {0x50c62262c539bb66ull, 0x2, 227, 198, 1, 77}, {0x803f4d4fef86302eull, 0x2, 250, 12, 1, 108},
+    {0x938437a1bd5b7387ull, 0x2, 240, 0, 0, 104}, {0xf2b2ea2be6e5532cull, 0x8, 20, 134, 1, 51},
+    {0x50d2118cebdc1002ull, 0x2, 151, 0, 0, 81}, {0xd91ab7abb4486bf9ull, 0x2, 280, 208, 1, 112},
+    {0x528fabf5533b992eull, 0xa, 0, 0, 0, 80}, {0x448ceb5b94018ed9ull, 0x2, 274, 231, 1, 120},
+    {0x72f5687f20d1cf38ull, 0x2, 186, 0, 0, 239}, {0x869e6813516ea906ull, 0x2, 8, 52, 1, 39},
+    {0xb2317d479726b9f6ull, 0x2, 226, 45, 1, 116}, {0x1b6d613fa50f15ceull, 0x2, 288, 229, 1, 122},
+    {0x55edd6980045f58full, 0x2, 0, 0, 0, 114}, {0xe393b56cedfac8f7ull, 0x8, 99, 72, 1, 52},
+    {0x00812f276edfeb62ull, 0x8, 221, 98, 1, 52}, {0x5ded8ee204763e3dull, 0x2, 167, 41, 1, 110},
+    {0xc69793a6b16dfeacull, 0x8, 342, 130, 1, 51}, {0x0c357d68c03ec832ull, 0x2, 48, 0, 0, 68},
+    {0x424429c26f2d09e0ull, 0x8, 254, 132, 1, 50}, {0xdb588b77fa6e5eb8ull, 0x2, 300, 0, 0, 99},
+    {0x8406bc072df19b0cull, 0x2, 226, 49, 1, 126}, {0x1d02a6b5a2b9ef93ull, 0x2, 383, 257, 1, 112},
+    {0x280fe39ed2e934dcull, 0x8, 90, 77, 1, 53}, {0x8d93df548331de80ull, 0x2, 277, 252, 1, 122},
+    {0xfd6775d050f32c29ull, 0x2, 8, 151, 1, 106}, {0x00a096019d1201d7ull, 0x2, 64, 234, 1, 122},
+    {0x2f7965fefb606828ull, 0x2, 295, 196, 1, 122}, {0xdeb5ef9a3fbce899ull, 0x2, 184, 0, 0, 108},
+    {0x87d4375a9b011a6bull, 0x2, 300, 282, 1, 104}, {0x5068f6f906b07827ull, 0x2, 226, 46, 1, 117},
+    {0xef278f1dba4a313bull, 0x2, 193, 149, 1, 120}, {0xab8703d78d0be3fcull, 0x2, 0, 0, 0, 66},
+    {0x89329a4c3a5c114full, 0x2, 225, 301, 1, 119}, {0xcfb0c07854f7bce9ull, 0x2, 321, 205, 1, 98},
+    {0x6be859712002f46dull, 0x2, 295, 195, 1, 120}, {0x309443c6a9a8aba0ull, 0x2, 0, 0, 0, 117},
+    {0x9b48492c8d4bb268ull, 0x2, 105, 162, 1, 114}, {0x22a58a0f103353e5ull, 0x8, 42, 84, 1, 49},
+    {0xa614000f72f02b71ull, 0x2, 0, 173, 1, 87}, {0xa7a8a11098b38f6cull, 0x2, 227, 199, 1, 100},
+    {0x67d63966f902c9b0ull, 0x8, 332, 83, 1, 52}, {0x9eb9d470ebe38cf8ull, 0x8, 212, 100, 1, 51},
+    {0x1a28fc33502ee466ull, 0x2, 277, 245, 1, 67}, {0x6b4bd2f5c016f65aull, 0x2, 300, 286, 1, 120},
+    {0x03c4306c22d41815ull, 0x2, 185, 239, 1, 99}, {0x1f62de08ad1263c9ull, 0x8, 8, 55, 1, 49},
+    {0x878dcc583d08e81full, 0x2, 37, 296, 1, 99}, {0xb6a908846b878229ull, 0x2, 195, 0, 0, 119},
+    {0xdb28c7e1c58418baull, 0x8, 212, 92, 1, 49}, {0x70d258f6ac9c6708ull, 0x2, 8, 0, 0, 115},
+    {0x5e716c157235e22cull, 0x8, 231, 122, 1, 52}, {0x3e6882567802c3ffull, 0x2, 14, 280, 1, 120},
+    {0x0db260fa943a817eull, 0x2, 339, 307, 1, 114}, {0xee2a625bc24de4d2ull, 0x2, 307, 54, 1, 51},
+    {0x8cf74f63e6f72459ull, 0x8, 254, 140, 1, 52}, {0x8452b92f6d1405ffull, 0x2, 222, 182, 1, 46},
+    {0xbcd8c37e0be8ddddull, 0x2, 304, 302, 1, 104}, {0x15668d4381b25f8full, 0x2, 185, 243, 1, 121},
+    {0xa246fc2cd9497d1bull, 0x2, 184, 0, 0, 110}, {0x710b7aeb6c0d3210ull, 0x2, 277, 246, 1, 106},
+    {0x42f35c9609021899ull, 0x8, 72, 172, 1, 84}, {0xe7b7c6a4459efbd2ull, 0x2, 230, 233, 1, 122},
+    {0x27c3155a885ac255ull, 0x2, 0, 0, 0, 104}, {0x57ee68493a61fd9dull, 0x8, 47, 65, 1, 52},
+    {0xf47c8f17d89e924eull, 0x2, 151, 185, 1, 101}, {0x81eeed4cf25b6187ull, 0x2, 330, 276, 1, 77},
+    {0x3ed875fac4757b28ull, 0x6, 0, 0, 0, 109}, {0x5748847c0dbb23f2ull, 0x2, 185, 241, 1, 108},
+    {0x6929ecaf3b488b6bull, 0x2, 250, 9, 1, 105}, {0x5f147d83fb1017b7ull, 0x8, 42, 85, 1, 51},
+    {0x40a473bf4500b4c1ull, 0x8, 359, 0, 0, 53}, {0xbc3510159c670c74ull, 0x8, 223, 170, 1, 84},
+    {0xb86075e8c3b02d67ull, 0x2, 277, 0, 0, 66}, {0x39d6694b74ee30ebull, 0x2, 8, 145, 1, 104},
+    {0xead901fab3322482ull, 0x2, 250, 23, 1, 120}, {0x71fb1b146708e3a6ull, 0x2, 250, 20, 1, 116},
+    {0x69d3804f96dceae7ull, 0x2, 295, 190, 1, 67}, {0x0645165ecba808dbull, 0x2, 146, 285, 1, 108},
+    {0xcc899b710492501cull, 0x8, 340, 138, 1, 50}, {0x9859bcbd0735b946ull, 0x8, 56, 141, 1, 49},
+    {0x3ba8bf0c021df7c1ull, 0x2, 295, 191, 1, 77}, {0x85be97c5edd2e3abull, 0x2, 184, 166, 1, 126},
+    {0x5ab312ba7fe19737ull, 0x2, 139, 287, 1, 67}, {0xa511aa5a47a9a5d8ull, 0x2, 281, 237, 1, 99},
+    {0x98e08fc02a223201ull, 0x8, 99, 70, 1, 50}, {0x34402328cca88ef1ull, 0x2, 149, 207, 1, 98},
+    {0x5a189954faa994d7ull, 0x2, 381, 268, 1, 67}, {0x2e848dec12a4fc30ull, 0x8, 65, 66, 1, 50},
+    {0x8d2fcc3d20adef95ull, 0x8, 332, 74, 1, 49}, {0x860e1c325e767bc5ull, 0x8, 162, 126, 1, 51},
+    {0x9e80c947deff9d51ull, 0x2, 211, 266, 1, 99}, {0xfb649ca57548a1aeull, 0x8, 129, 106, 1, 49},
+    {0x5ae5ba7abb761d73ull, 0x2, 250, 17, 1, 113}, {0x4797c8923391c66aull, 0x2, 226, 48, 1, 120},
+    {0xe212ffde89e2e153ull, 0x2, 14, 278, 1, 108}, {0xb2895f095fbee246ull, 0x8, 332, 78, 1, 50},
+    {0x86681cdab659a23eull, 0x2, 133, 271, 1, 110}, {0xb9b6ee97c87f373cull, 0x8, 47, 69, 1, 53},
+    {0xc345a3f3a0b0e934ull, 0x2, 60, 163, 1, 110}, {0xc6475d5f23da4efdull, 0x8, 90, 76, 1, 52},
+    {0x60c0d4908ef6d87cull, 0x8, 349, 58, 1, 51}, {0x45e0b7e222764816ull, 0x2, 64, 227, 1, 107},
+    {0x99fc3e2875273ac3ull, 0x8, 50, 94, 1, 52}, {0x407e75e1493ab770ull, 0x2, 184, 0, 0, 109},
+    {0x0990549da6810467ull, 0x2, 341, 189, 1, 119}, {0x64cf0d592363b56dull, 0x8, 342, 129, 1, 50},
+    {0x244595eecf7db9f4ull, 0x8, 162, 125, 1, 50}, {0x9b48e7857e79d34aull, 0x2, 29, 161, 1, 114},
+    {0x14223db8faca5abeull, 0x2, 143, 37, 1, 114}, {0xbb02aba8a560fd9cull, 0x2, 226, 33, 1, 97},
+    {0x3718097fd4b083c8ull, 0x8, 99, 71, 1, 51}, {0x13be4670e08f588dull, 0x8, 231, 114, 1, 50},
+    {0x1e76c7059e70eeadull, 0x2, 250, 15, 1, 111}, {0x38caf1ccdf498456ull, 0x2, 182, 213, 1, 112},
+    {0x52148c0e6537e1f8ull, 0x2, 250, 2, 1, 98}, {0x2ac48fffd459fd85ull, 0x8, 297, 103, 1, 50},
+    {0xf3b55cb71aaf5c45ull, 0x2, 14, 279, 1, 114}, {0x084caf0a70fed207ull, 0x2, 346, 223, 1, 122},
+    {0xd0266b62341bab7eull, 0x2, 185, 240, 1, 104}, {0x22fa9951789714c5ull, 0x8, 165, 175, 1, 81},
+    {0xb44528a3a1d0a443ull, 0x8, 349, 59, 1, 52}, {0xfe4be897ef1b917cull, 0x2, 191, 218, 1, 110},
+    {0xd544108e9844ade9ull, 0x2, 246, 35, 1, 114}, {0x3953965dc31fd172ull, 0x2, 226, 43, 1, 112},
+    {0xe55729f5793d91d0ull, 0x2, 329, 0, 0, 68}, {0xd3c3a158f798b5f7ull, 0x2, 250, 21, 1, 117},
+    {0xf04c05c1f6bdd387ull, 0x2, 250, 5, 1, 101}, {0x5406aecfb9d961beull, 0x8, 212, 105, 1, 53},
+    {0xea3bfba85848b711ull, 0x2, 260, 267, 1, 111}, {0xa598e01a5c5be6c9ull, 0x2, 250, 11, 1, 107},
+    {0x4ca1884603a3ed7bull, 0x2, 250, 24, 1, 121}, {0xb7b65ce49252224cull, 0x2, 0, 0, 0, 113},
+    {0x160daeec34c2123aull, 0x8, 349, 60, 1, 53}, {0xdd5cbdfe64b0ff5aull, 0x8, 90, 75, 1, 51},
+    {0xcaf272f4a52ee664ull, 0x2, 250, 6, 1, 102}, {0xb44656620f9e185eull, 0x2, 226, 30, 1, 45},
+    {0x07616665ca595932ull, 0x2, 250, 8, 1, 104}, {0x925cca093f2669e9ull, 0x2, 0, 0, 0, 116},
+    {0x904d1437655eb6d9ull, 0x8, 65, 67, 1, 51}, {0x30104fc17c92bfccull, 0x2, 196, 201, 1, 77},
+    {0x14688dc95b9bf95aull, 0x2, 184, 159, 1, 46}, {0xa3ed4b0b1e6b6cfeull, 0x2, 226, 36, 1, 108},
+    {0xaa7c8b57ca4f26ddull, 0x2, 28, 197, 1, 77}, {0x4224c4c5916d969full, 0x2, 226, 38, 1, 109},
+    {0x2098ad4e92c22010ull, 0x2, 300, 283, 1, 114}, {0xceb8daa263d2694eull, 0x8, 353, 80, 1, 49},
+    {0x230d8bdd8744d8faull, 0x2, 183, 0, 0, 140}, {0x4d1ca82d5087b530ull, 0x2, 0, 0, 0, 101},
+    {0xc2804e783fb268c8ull, 0x8, 263, 180, 1, 82}, {0xd43ec14f9acf09bcull, 0x2, 0, 0, 0, 97},
+    {0xd9b1c5170792feb2ull, 0x2, 0, 51, 1, 76}, {0xfda097cc9b147911ull, 0x2, 277, 250, 1, 115},
+    {0x2448d4c58e233901ull, 0x8, 263, 181, 1, 83}, {0x9b8370f0de537449ull, 0x8, 42, 86, 1, 53},
+    {0xd4796d2ed2f5be55ull, 0x2, 133, 272, 1, 114}, {0xc4e268dda0659874ull, 0x2, 260, 262, 1, 98},
+    {0xdd0fefb25a7e2ca3ull, 0x6, 0, 0, 0, 110}, {0x8e837f7b80338236ull, 0x2, 250, 4, 1, 100},
+    {0xc7c68cd17ccd5e6dull, 0x8, 359, 0, 0, 49}, {0xdf2802e9c0b641d4ull, 0x8, 160, 168, 1, 84},
+    {0xfca8e5d6e44fd02dull, 0x8, 231, 123, 1, 53}, {0xed68fb0935eb1fa9ull, 0x2, 0, 0, 0, 47},
+    {0xeb5421efed0c7f1bull, 0x2, 0, 0, 0, 102}, {0x17754f18970f68ffull, 0x8, 245, 0, 0, 97},
+    {0xf505d3735d9a75ceull, 0x2, 372, 0, 0, 102}, {0x677e5798399e80bcull, 0x2, 226, 40, 1, 110},
+    {0xfe8bbcdc054abc81ull, 0x2, 64, 224, 1, 51}, {0x11e8ec4f26e289f8ull, 0x2, 58, 303, 1, 108},
+    {0xa26cfa06d3bf7d08ull, 0x8, 359, 0, 0, 52}, {0x21416bf4167419bdull, 0x2, 133, 269, 1, 77},
+    {0xc21cc96ee2642973ull, 0x2, 64, 220, 1, 49}, {0x6037d746b4546781ull, 0x2, 350, 1, 1, 114},
+    {0x7cfca7e528df5a5cull, 0x2, 19, 297, 1, 112}, {0x5af0e6bd41183a0full, 0x2, 14, 277, 1, 104},
+    {0x6e6a48b64c5ab138ull, 0x2, 139, 288, 1, 100}, {0x1df7b04520505f48ull, 0x8, 262, 63, 1, 52},
+    {0x7f472deaee794136ull, 0x2, 364, 304, 1, 67}, {0xf7f4720893472034ull, 0x2, 8, 156, 1, 119},
+    {0x037719271bbd11b4ull, 0x8, 170, 171, 1, 84}, {0xf3ed34757b45a5beull, 0x2, 283, 260, 1, 98},
+    {0xec76d438bc144ab6ull, 0x2, 228, 0, 0, 68}, {0x82d7134bdf596faaull, 0x2, 10, 0, 0, 188},
+    {0xf0c725b6c0a86f2full, 0x2, 0, 158, 1, 81}, {0x643208cd954726c7ull, 0x2, 0, 0, 0, 106},
+    {0xcc4e7ae51df5d746ull, 0x2, 215, 0, 0, 120}, {0x3c8b80f5a531c18cull, 0x2, 283, 0, 0, 81},
+    {0x155db916291beba3ull, 0x2, 176, 289, 1, 67}, {0xed201fadac1939ceull, 0x8, 359, 0, 0, 50},
+    {0x790bf121b9034428ull, 0x2, 228, 214, 1, 99}, {0x898b9ba67aab3162ull, 0x2, 0, 0, 0, 103},
+    {0xdaefbcb0fef32ac3ull, 0x2, 211, 264, 1, 97}, {0x0a9910143d501401ull, 0x2, 75, 148, 1, 113},
+    {0x43d059daf165ac80ull, 0x2, 250, 10, 1, 106}, {0x9aff87614ee6bc3cull, 0x2, 21, 0, 0, 104},
+    {0x87c2120e8ca95e12ull, 0x2, 227, 200, 1, 114}, {0xb9a14833a6df8e98ull, 0x2, 364, 305, 1, 122},
+    {0xe96bce80a53c51cfull, 0x8, 221, 97, 1, 49}, {0xd99fe93de3327efdull, 0x2, 226, 31, 1, 46},
+    {0x3563ca3f789b9efbull, 0x2, 74, 244, 1, 126}, {0x2747f571deb08810ull, 0x2, 250, 25, 1, 122},
+    {0x040f82706c4833c2ull, 0x2, 184, 164, 1, 111}, {0x060db31f7690e649ull, 0x8, 332, 87, 1, 53},
+    {0x0a1965c332b77fb9ull, 0x8, 189, 169, 1, 84}, {0xb808547df6d88eb0ull, 0x2, 145, 39, 1, 114},
+    {0x6249b56ef9c1bd2bull, 0x8, 221, 99, 1, 53}, {0x501e22d0846f18a2ull, 0x8, 297, 104, 1, 53},
+    {0x4b6326c6d190ed91ull, 0x2, 11, 53, 1, 39}, {0x60d3de28ca6c14b6ull, 0x1, 0, 50, 1, 72},
+    {0xfce4a2eeedcb7c20ull, 0x2, 226, 44, 1, 114}, {0x1866bceec1b5a44bull, 0x2, 260, 263, 1, 101},
+    {0xe2f3ea9240f0cfcbull, 0x8, 8, 91, 1, 51}, {0xe207d3957f0f42cfull, 0x2, 250, 13, 1, 109},
+    {0x8efe9f6eb22f45ecull, 0x1, 0, 167, 1, 82}, {0xd29adf3d3e12dd51ull, 0x2, 8, 152, 1, 114},
+    {0x83f3f8167b483fb3ull, 0x2, 192, 265, 1, 99}, {0xe3e34edeec224a6cull, 0x2, 37, 298, 1, 119},
+    {0x18af9765841a7163ull, 0x2, 299, 0, 0, 68}, {0xfeef41f6dd3f1ceaull, 0x8, 263, 178, 1, 80},
+    {0x3bdd22382c7b4eb4ull, 0x2, 339, 308, 1, 120}, {0x3cf14e2c7afdda01ull, 0x8, 212, 96, 1, 50},
+    {0x749a883fd54ee27full, 0x2, 6, 0, 0, 46}, {0x8b5799601ed88b8full, 0x8, 359, 0, 0, 51},
+    {0xa9c9696c39729800ull, 0x2, 151, 184, 1, 99}, {0xcecbbd86da08ddabull, 0x2, 0, 0, 0, 118},
+    {0xe7f5f742f0674fbaull, 0x2, 0, 28, 1, 68}, {0xaee52e70ce310b99ull, 0x2, 0, 0, 0, 100},
+    {0x3d1151950dfb686cull, 0x2, 149, 212, 1, 111}, {0x45ae765ae866e5aaull, 0x8, 113, 115, 1, 49},
+    {0x0ee4c835eae4909full, 0x2, 64, 232, 1, 114}, {0x084d7d689bfbcc64ull, 0x8, 8, 109, 1, 52},
+    {0xbb857e99f2644cc2ull, 0x2, 8, 157, 1, 121}, {0x9a131ab5a8b1cd5bull, 0x2, 295, 193, 1, 110},
+    {0x40d907ae0e566e38ull, 0x8, 47, 56, 1, 49}, {0x379e4dcdea7c7ce6ull, 0x2, 149, 0, 0, 68},
+    {0xd2779ce47e48f4d8ull, 0x2, 149, 209, 1, 99}, {0xcfa15ced96ab6b23ull, 0x2, 384, 154, 1, 122},
+    {0xf5fffe0bffc5d5aeull, 0x2, 85, 0, 0, 68}, {0x358c27a5465a7fc8ull, 0x2, 250, 18, 1, 114},
+    {0x7e93b8398a7d691eull, 0x2, 226, 0, 0, 99}, {0x2cbaf93816a53c15ull, 0x2, 250, 7, 1, 103},
+    {0xfce67d53115b5d0full, 0x2, 379, 292, 1, 110}, {0x816dfedcdacd6376ull, 0x2, 371, 0, 0, 113},
+    {0x3b0b721b63bed6f6ull, 0x2, 184, 165, 1, 120}, {0xe282f37a54f2b8a7ull, 0x8, 0, 0, 0, 89},
+    {0x2b0f64295bac657aull, 0x2, 226, 0, 0, 104}, {0x329653c642ba11d6ull, 0x2, 49, 281, 1, 97},
+    {0x7586ccb552048b4eull, 0x8, 231, 110, 1, 49}, {0x744abb7084341a6eull, 0x2, 158, 256, 1, 120},
+    {0x0838664fa7894f81ull, 0x2, 163, 0, 0, 47}, {0x03e8e644d332f264ull, 0x2, 166, 0, 0, 116},
+    {0xfa2afdbf12906ceaull, 0x8, 248, 111, 1, 50}, {0x1f54bdd11d9fce44ull, 0x2, 339, 306, 1, 104},
+    {0xa684f7276cfd1a25ull, 0x8, 8, 127, 1, 53}, {0x84c31f92c9e19e86ull, 0x8, 165, 176, 1, 82},
+    {0xb3dd1256e8a19711ull, 0x2, 250, 3, 1, 99}, {0xe44f3c04138e384bull, 0x8, 129, 108, 1, 52},
+    {0xfa4004bd6eed3818ull, 0x2, 75, 147, 1, 50}, {0x15c7b72babbf1da7ull, 0x2, 225, 299, 1, 104},
+    {0x7b47696deb70866aull, 0x2, 0, 0, 0, 111}, {0x9754adefd055a981ull, 0x2, 250, 19, 1, 115},
+    {0x7d47fb1ced0c937aull, 0x8, 47, 61, 1, 51}, {0x09311ce46f7017c7ull, 0x8, 245, 0, 0, 105},
+    {0xb1f5c02c7369e66cull, 0x8, 231, 118, 1, 51}, {0x0b91efafab602a49ull, 0x2, 151, 183, 1, 98},
+    {0x2bc7ad88d9e46c0dull, 0x2, 310, 251, 1, 104}, {0xa44cdba6d76de7e2ull, 0x2, 149, 215, 1, 121},
+    {0xe7482f9c0673983cull, 0x2, 139, 293, 1, 120}, {0xb39e06f93520864eull, 0x2, 185, 242, 1, 120},
+    {0x55b5babbc94c5fdfull, 0x2, 283, 261, 1, 99}, {0xeebfd5a977fc4e20ull, 0x8, 254, 144, 1, 53},
+    {0x5424ea16b20746ceull, 0x2, 64, 226, 1, 99}, {0x5bf383fd9be11aedull, 0x8, 248, 113, 1, 53},
+    {0x343e5b08be1184bcull, 0x2, 64, 230, 1, 113}, {0x13a784db4ee18a7aull, 0x2, 282, 249, 1, 108},
+    {0xd4c8b02a62c8d5d4ull, 0x8, 56, 143, 1, 51}, {0xa0a0fc44b66bbad1ull, 0x2, 0, 0, 0, 108},
+    {0x33f5195e63d9a749ull, 0x8, 264, 120, 1, 50}, {0x80a94f620b807b32ull, 0x8, 203, 89, 1, 51},
+    {0xb1c31ac9f45db6baull, 0x2, 87, 0, 0, 68}, {0xc5fa8f131a589c34ull, 0x2, 0, 0, 0, 105},
+    {0x9bd811802b9bcf78ull, 0x2, 277, 248, 1, 114}, {0x9f88d60cf910e2a7ull, 0x2, 260, 258, 1, 97},
+    {0x0ee690559bbd8956ull, 0x2, 149, 210, 1, 101}, {0x403c79c3263207b8ull, 0x2, 66, 186, 1, 99},
+    {0x9fe18ce87b7fabbfull, 0x2, 191, 217, 1, 77}, {0xa7c7ce5257706e26ull, 0x2, 341, 188, 1, 118},
+    {0x2e4f97dad2e987dbull, 0x2, 103, 228, 1, 120}, {0x29267facb480a725ull, 0x2, 187, 0, 0, 46},
+    {0xc0878b4aa2954833ull, 0x1, 0, 309, 1, 126}, {0x9cc33691967862d8ull, 0x2, 64, 221, 1, 50},
+    {0x8ea59e15778065dbull, 0x2, 225, 300, 1, 108}, {0x6de83a34c7fdea90ull, 0x2, 321, 206, 1, 99},
+    {0x20be2f77357dabcdull, 0x8, 129, 107, 1, 50}, {0x10adb4bcbca059feull, 0x2, 0, 0, 0, 99},
+    {0xe7765c3b4f100c16ull, 0x2, 64, 225, 1, 52}, {0xf23e288108c7d7dfull, 0x8, 212, 101, 1, 52},
+    {0x499f28c12388e457ull, 0x8, 162, 124, 1, 49}, {0x06da30a5d90bfe21ull, 0x2, 281, 235, 1, 98},
+    {0xf42550538f5f3fceull, 0x2, 0, 0, 0, 115}, {0xafc6167e0a1d7276ull, 0x2, 215, 153, 1, 104},
+    {0xb643f6bcc6c2bfeeull, 0x8, 20, 133, 1, 49}, {0x859897acd92e5d09ull, 0x2, 235, 203, 1, 112},
+    {0x6d03373943861412ull, 0x2, 0, 0, 0, 119}, {0xad7a6e5e8938af5eull, 0x2, 277, 247, 1, 108},
+    {0x1a1be7b3d005f5a3ull, 0x8, 342, 131, 1, 52}, {0xe4279cb25bcc6028ull, 0x2, 11, 0, 0, 49},
+    {0x88c20a9e9bb55331ull, 0x2, 289, 259, 1, 46}, {0x98627776800246d3ull, 0x8, 248, 112, 1, 51},
+    {0x767e7eb2c0c94215ull, 0x2, 277, 0, 0, 119}, {0xf1e32e4d6de6653full, 0x8, 340, 137, 1, 49},
+    {0xb146cb82b6e02e19ull, 0x2, 126, 295, 1, 112}, {0x75c289cca60c15c4ull, 0x2, 226, 47, 1, 118},
+    {0xdf2836903bbfa780ull, 0x2, 238, 238, 1, 112}, {0xf5763719c52123bcull, 0x2, 199, 32, 1, 46},
+    {0x5b4fbc9056d490d5ull, 0x8, 203, 90, 1, 52}, {0x3833b7e7fb8cf88aull, 0x8, 50, 95, 1, 53},
+    {0xf91d3436234feb4aull, 0x2, 250, 16, 1, 112}, {0x68aad5ef91785b8eull, 0x8, 262, 62, 1, 50},
+    {0x06063601104bf8fbull, 0x4, 354, 253, 1, 103}, {0x9608a96b5f1a50daull, 0x2, 149, 204, 1, 97},
+    {0xf4126d7038a62393ull, 0x8, 353, 81, 1, 52}, {0xa2e44919f9d32d06ull, 0x2, 295, 192, 1, 99},
+    {0xccd08f74a16f1c8eull, 0x8, 113, 117, 1, 53}, {0x70cbdeaf7fc203ddull, 0x2, 341, 187, 1, 77},
+    {0xc132130fe71ec214ull, 0x8, 165, 174, 1, 80}, {0xa64eabec4a20a10full, 0x2, 133, 273, 1, 120},
+    {0x7aa5c88d3ad47392ull, 0x2, 75, 150, 1, 122}, {0xe95652a5c8ae9bfeull, 0x2, 37, 294, 1, 98},
+    {0xe2bd9f5b63060c8dull, 0x2, 133, 275, 1, 122}, {0x4e731e8ccbbf52f1ull, 0x2, 142, 160, 1, 46},
+    {0x44bc70d9fdc69992ull, 0x8, 8, 73, 1, 50}, {0x95bd9fa2d0ca0c92ull, 0x8, 264, 119, 1, 49},
+    {0x90ea63e175ef614bull, 0x8, 20, 135, 1, 52}, {0xbcae40bb0863576cull, 0x2, 250, 14, 1, 110},
+    {0xa55490b039f31a8aull, 0x2, 191, 219, 1, 120}, {0x821d69cfd34101c8ull, 0x8, 113, 116, 1, 51},
+    {0x05b5d154ac1832ddull, 0x2, 226, 42, 1, 111}, {0x47a9a46494320137ull, 0x2, 0, 0, 0, 122},
+    {0xa40cb003dda44bf9ull, 0x8, 254, 136, 1, 51}, {0x72763b012932581full, 0x2, 0, 0, 0, 98},
+    {0x679dbc90c3c1373bull, 0x8, 254, 128, 1, 49}, {0x08f88eea18b7f483ull, 0x8, 340, 139, 1, 52},
+    {0x599750c9756a7328ull, 0x2, 227, 202, 1, 120}, {0xc8fc09be4627b346ull, 0x8, 297, 102, 1, 49},
+    {0xefe5e9fefb163804ull, 0x2, 291, 222, 1, 112}, {0x60b7c834af44d6f3ull, 0x8, 263, 179, 1, 81},
+    {0x2f4096c9bb6accc9ull, 0x2, 218, 236, 1, 112}, {0x1b7f74d85d866153ull, 0x8, 47, 57, 1, 50},
+    {0x26b9e872467f158eull, 0x2, 251, 0, 0, 101}, {0x87c4773fd7914592ull, 0x2, 149, 211, 1, 105},
+    {0xbf6cad81012cc8b6ull, 0x2, 295, 194, 1, 115}, {0x50c0d8c4cd385007ull, 0x8, 332, 79, 1, 51},
+    {0xb30e626bf9e617cdull, 0x4, 68, 0, 0, 110}, {0xae6a0e8f94354714ull, 0x2, 250, 22, 1, 118},
+    {0x90d31fdfb722fe7eull, 0x4, 158, 255, 1, 104}, {0x165b64634c6c8298ull, 0x2, 133, 270, 1, 103},
+    {0x8841cbd6129ef824ull, 0x2, 68, 254, 1, 118}, {0xcb6d92db9f1c200aull, 0x8, 0, 0, 0, 84},
+    {0xdb0039dc3376e01full, 0x8, 65, 68, 1, 53}, {0x96def3f53bc9ed2aull, 0x2, 33, 26, 1, 114},
+    {0xbc2f29faae411681ull, 0x8, 262, 64, 1, 53}, {0x443a5bf131e7d840ull, 0x8, 203, 88, 1, 49},
+    {0x0b3ab0f3f33fae45ull, 0x2, 0, 0, 0, 120}, {0x6c6db58e395a3968ull, 0x2, 51, 0, 0, 114},
+    {0x2c453f3ef7e95856ull, 0x2, 33, 27, 1, 126}, {0xe92f475f28a2fccaull, 0x2, 379, 291, 1, 67},
+    {0x55daf3bcb63d51eaull, 0x8, 353, 82, 1, 53}, {0x22c0d95efef00923ull, 0x2, 164, 216, 1, 119},
+    {0x8ed6265aef02d86dull, 0x2, 327, 274, 1, 122}, {0x87aef4ea55cbba81ull, 0x2, 148, 0, 0, 80},
+    {0x776e1ee3ccc4fa63ull, 0x2, 250, 0, 1, 97}, {0xe4af63d49a7cfdb5ull, 0x8, 50, 93, 1, 50},
+    {0x1cdfb8c09900c74eull, 0x8, 264, 121, 1, 53}, {0xe68ba5da44f3c8f7ull, 0x8, 165, 177, 1, 83},
+    {0x730029e5dbd69ff5ull, 0x8, 56, 142, 1, 50}, {0x98777e70ff8c6a43ull, 0x2, 75, 146, 1, 49},
+    {0xfef97c0946262290ull, 0x2, 226, 29, 1, 43}, {0x1572f0da9e8c3b66ull, 0x2, 139, 290, 1, 114},
+    {0xa7049bfadc59f0e6ull, 0x2, 4, 34, 1, 114}, {0x197ee3277b61500dull, 0x2, 0, 0, 0, 112},
+    {0x8d672f7c976fb21full, 0x2, 146, 284, 1, 104}, {0x411e7a6664769ae5ull, 0x2, 260, 0, 0, 68},
+    {0x401c38b8023e2df6ull, 0x2, 243, 0, 0, 120},
+};
+
+inline constexpr uint32_t kBuiltinSchemeDisplacements[] = {
+    0, 0, 0, 2, 0, 3, 0, 0, 0, 2, 1, 7,
+    6, 6, 14, 2, 0, 1, 1, 1, 4, 4, 3, 4,
+    0, 2, 0, 5, 0, 1, 8, 0, 5, 0, 0, 3,
+    8, 5, 2, 14, 0, 1, 1, 9, 6, 2, 0, 10,
+    0, 1, 1, 2, 12, 2, 0, 2, 4, 0, 0, 0,
+    0, 13, 0, 4, 1, 3, 0, 8, 0, 0, 3, 31,
+    0, 8, 0, 1, 0, 2, 0, 12, 10, 16, 2, 0,
+    8, 34, 0, 21, 0, 15, 19, 17, 8, 8, 8, 9,
+    5, 1, 34, 3, 0, 0, 6, 11, 44, 5, 0, 29,
+    1, 15, 0, 0, 14, 13, 0, 16, 0, 4, 9, 5,
+    4, 25, 12, 0, 0, 5, 0, 7, 32, 0, 3, 34,
+    23, 0, 22, 5, 8, 49, 21, 13, 34, 1, 0, 8,
+    216, 17, 56, 87, 3, 4, 10, 0, 63, 2, 0, 0,
+    1, 2, 44, 1, 0, 0, 106, 12, 1, 109, 8, 33,
+    0, 6, 0, 8, 29, 9, 91, 1, 11, 77, 65, 23,
+    114, 5, 0, 1, 25, 2, 93, 130, 384, 12, 0, 60,
+};
+
+inline constexpr StaticSchemes kBuiltinSchemes{
+    kBuiltinSchemeSources, 4,
+    kBuiltinSchemeNodes, 385,
+    kBuiltinSchemeDisplacements, 192,
+    kBuiltinSchemeKeys, 310,
+    kBuiltinSchemeEntries, 314,
+    kBuiltinSchemeValues, 272,
+    nullptr, 0,
+};
@@ -0,0 +1,127 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <optional>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include "Engine.hpp"
+
+// 后台候选计算：新请求取代旧请求并让正在算的尽快停下，结果通过回调交出
+class CandidateWorker {
+public:
+    struct Request {
+        uint64_t tag = 0;          // 调用方的标记（如 Engine::version()），原样带回结果
+        std::shared_ptr<const Dictionary> dict;  // 用哪份字典算，算完前一直持有
+        std::string code;          // Engine::activeBuffer()
+        std::u32string committed;  // Engine::committed()
+        size_t count = 0;          // 要前 count 个候选
+        size_t beam_width = 0;     // Engine::beamWidth()
+    };
+    struct Result {
+        uint64_t tag = 0;
+        std::vector<std::u32string> items;
+        bool complete = false;     // 不足 count 个，items 已是全部候选
+    };
+    // 在工作线程上调用，只应投递消息；结果可能已过时，调用方按 tag 丢弃
+    using Callback = std::function<void(Result&&)>;
+
+    explicit CandidateWorker(Callback done, const UserHistory* history = nullptr); // history 须比 worker 活得久
+    ~CandidateWorker();
+    CandidateWorker(const CandidateWorker&) = delete;
+    CandidateWorker& operator=(const CandidateWorker&) = delete;
+
+    void submit(Request req); //取代所有未完成的请求
+    void cancel();            //丢掉未完成的请求并等正在算的停下
+
+private:
+    void run();
+
+    Callback done_;
+    Converter conv_ { nullptr };       // 只在工作线程上用
+    std::shared_ptr<const Dictionary> dict_;  // conv_ 当前用的快照，只在工作线程上用
+    std::mutex mutex_;
+    std::condition_variable wake_;     // 有新请求或要退出
+    std::condition_variable idle_;     // 当前请求算完（或被中断）
+    std::optional<Request> pending_;   // 还没开始的请求，只留最新的一个
+    bool busy_ = false;                // 工作线程正在算
+    bool stop_ = false;
+    std::atomic<bool> stale_{false};   // 正在算的请求已被取代
+    std::thread thread_;               // 最后启动：其余成员都已初始化
+};
+// 执行层
+inline CandidateWorker::CandidateWorker(Callback done, const UserHistory* history)
+    : done_(std::move(done))
+{
+    conv_.setInterrupt(&stale_);
+    conv_.setHistory(history);
+    thread_ = std::thread([this] { run(); });
+}
+
+inline CandidateWorker::~CandidateWorker()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+        pending_.reset();
+        stale_.store(true, std::memory_order_relaxed);
+    }
+    wake_.notify_one();
+    thread_.join();
+}
+
+inline void CandidateWorker::submit(Request req)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_ = std::move(req);
+        if (busy_) stale_.store(true, std::memory_order_relaxed);
+    }
+    wake_.notify_one();
+}
+
+inline void CandidateWorker::cancel()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    pending_.reset();
+    if (busy_) stale_.store(true, std::memory_order_relaxed);
+    idle_.wait(lock, [this] { return !busy_; });
+}
+
+inline void CandidateWorker::run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        wake_.wait(lock, [this] { return stop_ || pending_.has_value(); });
+        if (stop_)
+            return;
+        Request req = std::move(*pending_);
+        pending_.reset();
+        // 在锁内清标志：之后到来的 submit 一定能看到 busy_ 并重新置位
+        stale_.store(false, std::memory_order_relaxed);
+        busy_ = true;
+        lock.unlock();
+
+        if (req.dict != dict_) {
+            conv_.setDictionary(req.dict.get());
+            dict_ = std::move(req.dict);  // 旧快照在这里放手
+        }
+        conv_.setBeamWidth(req.beam_width);
+        Result result;
+        result.tag = req.tag;
+        result.items = Engine::candidatesFor(conv_, req.code, req.committed, req.count);
+        result.complete = result.items.size() < req.count;
+        if (!stale_.load(std::memory_order_relaxed) && done_)
+            done_(std::move(result));
+
+        lock.lock();
+        busy_ = false;
+        idle_.notify_all();
+    }
+}
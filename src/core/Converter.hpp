@@ -0,0 +1,832 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_set>
+#include <functional>
+#include <queue>
+#include <optional>
+#include <atomic>
+#include <thread>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include "Dic.hpp"
+#include "Arena.hpp"
+#include "UserHistory.hpp"
+#include "Trace.hpp"
+#include "Tone.hpp"
+#ifdef max
+#undef max
+#endif
+#ifdef min
+#undef min
+#endif
+//maxmin宏污染
+
+// 纯转换核心：输入码 -> 排好的候选，不含会话状态；一个对象同时只给一个线程用
+class Converter {
+public:
+    explicit Converter(const Dictionary* dict);
+    void assign(std::string_view code); //让词格对应 code：与上一次共同前缀的列保留，只增删尾部的列
+    void clear() { assign({}); }
+    void setDictionary(const Dictionary* dict); //换一份字典（如热重载发布的新快照）：按同一输入码重建词格
+    const std::string& code() const { return code_; }
+    std::vector<std::u32string> candidates(size_t k, size_t offset = 0); //按排名取第 offset 起的 k 个候选，只搜到需要的位置
+
+    void setInterrupt(const std::atomic<bool>* flag) { interrupt_ = flag; } //flag 置位后 assign 与 candidates 尽快返回，清掉后从断点接着算
+    bool interrupted() const { return interrupt_ && interrupt_->load(std::memory_order_relaxed); }
+
+    void setHistory(const UserHistory* history); //选过且拼得出的候选排在最前；nullptr 只按结构排名
+
+    void setBeamWidth(size_t width); //束搜索：每个位置只留前 width 个前缀，耗时与码长成线性但排名不保证精确；0 为精确搜索
+    size_t beamWidth() const { return beam_width_; }
+
+    // 无状态的一次性转换，可在任意线程调用
+    static std::vector<std::u32string> convert(const Dictionary& dict, std::string_view code, size_t k);
+    // 把一批输入码分块交给 threads 个线程转换；results[i] 对应 codes[i]，顺序与输入一致
+    static std::vector<std::vector<std::u32string>> convertBatch(const Dictionary& dict,
+        const std::vector<std::string_view>& codes, size_t k, unsigned threads = 0, size_t beam_width = 0);
+
+private:
+    const Dictionary* dict_;
+    std::string code_;  // 词格当前对应的输入码
+    const std::atomic<bool>* interrupt_ = nullptr;
+    const UserHistory* history_ = nullptr;
+    size_t beam_width_ = 0;
+
+    using Score = uint64_t;  // 越大越前：[63:48] T 转换数 [47:32] 最大 T 位数 [31:16] 总转换数 [15:0] 65535 - 段数
+    static constexpr Score kEmptyScore = 0xFFFF;  // 空路径：各项为 0
+    static constexpr Score kNoScore = 0;          // 不可达（段数 65535 才会打成 0）
+    static constexpr Score kPlainScore = 0xFFFE;  // 一段、没有转换、没有 T 位数：输出与输入码相同
+    static constexpr Score kTDigitsMask = 0xFFFFULL << 32;
+    static int tDigitsOf(Score s) { return static_cast<int>((s & kTDigitsMask) >> 32); }
+    static Score edgeScore(int t_digits, bool converted);
+    static Score combineScore(Score a, Score b);  // 拼接两段路径：各项相加，T 位数取最大
+    // 同上，但以续写开头的一段只能接在以原样输出长段结尾的路径后面，否则为 kNoScore
+    static Score joinScore(Score a, bool a_raw_end, Score b, bool b_extends);
+
+    // 值编号：字典里的值用驻留编号；原样输出的段和生成的调符不在字典里，编号带 kPassThroughBit，下标指向 pass_values_
+    static constexpr uint32_t kPassThroughBit = 0x80000000u;
+    std::u32string_view valueText(uint32_t value_id) const;
+
+    // 词格的一条边：输入码中 [from, 终点) 这一段输出编号为 value_id 的值
+    struct LatticeEdge {
+        uint32_t from;
+        uint32_t value_id;
+        Score score;     // 这一段单独的得分，接到路径上用 joinScore
+        uint64_t hash;   // 值的文本哈希与 kTextHashBase^|value|，接到前缀后面时直接组合
+        uint64_t scale;
+        bool raw;        // 原样输出的长段（或续写），后面还能接着续写
+        bool extends;    // 续写前面的原样输出长段：只能接在 raw 的边后面，不另算一段
+    };
+
+    // 候选路径：值编号串成的单链表，同一前缀被多条路径共用；哈希与长度是整段文本的，与怎么分段无关
+    struct PrefixNode {
+        uint32_t value_id;
+        uint32_t length;                 // 从开头到本段的码点数
+        const PrefixNode* prev;          // nullptr：到开头
+        uint64_t hash;                   // 从开头到本段的文本哈希
+        const char32_t* head = nullptr;  // 精确搜索：文本开头的 min(length, kHeadLength) 个码点，够长以后与前一段共用
+    };
+    static constexpr uint64_t kTextHashBase = 0x100000001B3ULL;
+    static constexpr uint32_t kHeadLength = 16;
+    // text(a) + a_tail 与 text(b) + b_tail 按码点比较：先比 head，再只比共用节点之后的几段
+    int compareText(const PrefixNode* a, std::u32string_view a_tail, const PrefixNode* b, std::u32string_view b_tail) const;
+    int compareText(const PrefixNode* a, const PrefixNode* b) const { return compareText(a, {}, b, {}); }
+    bool textEqual(const PrefixNode* a, const PrefixNode* b) const;
+    mutable std::vector<std::u32string_view> compare_segments_[2];  // compareText 的临时表，留着复用
+    std::u32string materialize(const PrefixNode* path) const;
+
+    struct BeamItem {
+        Score score;
+        const PrefixNode* path;  // nullptr：空路径
+        bool raw_end;            // 最后一段是原样输出的长段
+    };
+
+    // 词格的一列：输入码前 j 个字符对应的节点
+    struct LatticeColumn {
+        std::vector<LatticeEdge> edges;  // 以该节点结尾的所有边
+        std::vector<BeamItem> beam;      // 束搜索：到达该节点的前 beam_width_ 个前缀，文本互不相同
+        std::vector<std::pair<size_t, Dictionary::TrieNodeId>> open;  // 以该节点结尾、仍是某个键前缀的段（起点, 前缀树节点）
+        std::vector<uint32_t> pieces;    // 以该节点结尾、还没起长段的原样输出段的起点
+        Arena::Mark arena_mark;          // 建这一列之前 lattice_arena_ 的位置，弹出时退回
+        size_t pass_mark = 0;            // 建这一列之前 pass_values_ 的长度
+        uint32_t tone_start = kNoTone;   // 本列的字符是 T 或接在 T 后的 1-5 时，那个 T 的位置（见 Tone.hpp）；tones_ 为假时只用于原样输出
+    };
+    static constexpr uint32_t kNoTone = UINT32_MAX;
+
+    std::vector<LatticeColumn> lattice_;  // lattice_[j] 只依赖前 j 个字符：按键追加一列，退格弹出一列
+    uint64_t lattice_generation_ = 0;  // 建词格时字典的 generation
+    bool tones_ = false;               // 建词格时字典里有 tones 字库，才认调号
+    Arena lattice_arena_;              // 原样输出段的 UTF-32 文本，跟着列一起增减
+    std::vector<std::u32string_view> pass_values_;  // 原样输出段的文本（指向 lattice_arena_）
+    std::vector<std::pair<uint64_t, uint64_t>> value_hashes_;  // 字典值的 (哈希, 幂)，按驻留编号惰性填写，幂为 0 表示还没算
+
+    // 束搜索扩展时的一个候选前缀：还没分配节点，选进束里才分配
+    struct BeamCandidate {
+        Score score;
+        uint64_t hash;
+        uint32_t length;
+        const BeamItem* prev;
+        const LatticeEdge* edge;
+    };
+    std::vector<BeamCandidate> beam_scratch_;  // extendBeam 的临时表，留着复用
+    void extendBeam(LatticeColumn& col);       // 用前面各列的束算出 col 的束
+
+    const PrefixNode* appendPath(const PrefixNode* prefix, const LatticeEdge& e);  // 精确搜索：前缀接上一段
+
+    // 精确搜索中的一条前缀路径
+    struct Partial {
+        uint32_t pos;            // 前缀到 pos 为止
+        Score score;             // 前缀自身得分
+        Score bound;             // 接上最优后缀后的得分
+        const PrefixNode* path;  // 前缀输出
+        bool raw_end;            // 最后一段是原样输出的长段
+    };
+    struct PartialLower {
+        bool operator()(const Partial& a, const Partial& b) const { return a.bound < b.bound; }
+    };
+    struct PartialTextGreater {
+        const Converter* conv;
+        bool operator()(const Partial& a, const Partial& b) const { return conv->compareText(a.path, b.path) > 0; }
+    };
+
+    // 已展开的（位置, T 位数与是否以原样输出的长段结尾, 前缀文本）
+    struct ExpandedKey {
+        uint32_t pos;
+        uint32_t state;  // T 位数 * 2 + raw_end
+        const PrefixNode* path;
+    };
+    struct ExpandedHash {
+        size_t operator()(const ExpandedKey& k) const {
+            uint64_t h = k.path ? k.path->hash : 0;
+            h ^= (static_cast<uint64_t>(k.pos) << 8 | k.state) * 0x9E3779B97F4A7C15ULL;
+            return static_cast<size_t>(h ^ (h >> 29));
+        }
+    };
+    struct ExpandedEqual {
+        const Converter* conv;
+        bool operator()(const ExpandedKey& a, const ExpandedKey& b) const {
+            return a.pos == b.pos && a.state == b.state && conv->textEqual(a.path, b.path);
+        }
+    };
+
+    // 可续的候选搜索：翻页时从断点继续，词格一变就整块清掉（除 results 外都在 search_arena_ 上）
+    struct CandidateSearch {
+        CandidateSearch(const Converter* conv, Arena* arena)
+            : queue(PartialLower{}, std::vector<Partial, ArenaAllocator<Partial>>(ArenaAllocator<Partial>(arena))),
+              ties(PartialTextGreater{conv}, std::vector<Partial, ArenaAllocator<Partial>>(ArenaAllocator<Partial>(arena))),
+              text_greater{conv},
+              expanded(64, ExpandedHash{}, ExpandedEqual{conv}, ArenaAllocator<ExpandedKey>(arena)),
+              emitted(64, std::hash<std::u32string_view>{}, std::equal_to<std::u32string_view>{},
+                      ArenaAllocator<std::u32string_view>(arena)) {}
+
+        // 上界最高的一层放在 ties 里按前缀文本排，其余在 queue 里只按上界排（比较文本比比较分数贵得多）
+        std::priority_queue<Partial, std::vector<Partial, ArenaAllocator<Partial>>, PartialLower> queue;
+        std::priority_queue<Partial, std::vector<Partial, ArenaAllocator<Partial>>, PartialTextGreater> ties;
+        PartialTextGreater text_greater;
+        Score tie_bound = kNoScore;   // ties 这一层的上界
+        std::optional<Partial> lane;  // 刚展开出来、已知比 ties 里的都小的一条，下一个就处理它，不进堆
+        std::unordered_set<ExpandedKey, ExpandedHash, ExpandedEqual, ArenaAllocator<ExpandedKey>> expanded;
+        std::unordered_set<std::u32string_view, std::hash<std::u32string_view>, std::equal_to<std::u32string_view>,
+                           ArenaAllocator<std::u32string_view>> emitted;  // 已产出的文本（复制在 search_arena_ 上）
+        std::vector<std::u32string> results;  // 按排名产出的候选，到这里才生成字符串
+        uint64_t history_version = 0;         // 开始搜索时选词记录的版本
+    };
+    Arena search_arena_;
+    std::optional<CandidateSearch> search_;  // 空表示还没开始搜
+
+    // 精确搜索开始时按当前词格算一次，与 lattice_ 下标对应
+    struct SearchColumn {
+        std::vector<Score> suffix_best;  // suffix_best[2d + r]：从该节点到末尾、T 位数最大值恰为 d、r 为是否以续写开头的最优后缀（kNoScore 表示没有）
+        std::vector<std::pair<uint32_t, const LatticeEdge*>> out;  // 从该节点出发的边（终点, 边）
+    };
+    std::vector<SearchColumn> search_columns_;
+
+    void prepareSearch();                   // 从末尾反向算 search_columns_
+    Score bestCompletion(size_t pos, Score prefix, bool raw_end) const;
+    void resetLattice();                    // 只留起点
+    void resetSearch();                     // 作废搜索状态（search_arena_ 在下次搜索开始时清空）
+    void appendColumn(size_t j);            // 为输入码的第 j 个字符追加第 j 列
+    void produceCandidates(size_t count);   // 让 search_.results 至少有 count 个（或已搜完）
+    void produceBeamCandidates();           // 束搜索：末列的束就是全部候选
+    void pinLearned();                      // 新搜索开始时先产出选词记录里的候选
+    void emit(std::u32string text);         // 没产出过的文本加进 search_->results
+
+    // 词格里是否有一条从 pos 往前、恰好拼出 text 前 end 个码点的路径（raw_end：这条路径须以原样输出的长段结尾）
+    bool matchText(size_t pos, size_t end, std::u32string_view text, bool raw_end);
+    std::vector<char> dead_;                // matchText 的备忘：(pos, end, raw_end) 已知拼不出，留着复用
+};
+// 执行层
+inline Converter::Converter(const Dictionary* dict)
+    : dict_(dict)
+{
+    resetLattice();
+}
+
+// Sort: T-patterns > T-digits > conversions > fewer segments
+inline Converter::Score Converter::edgeScore(int t_digits, bool converted)
+{
+    Score s = 0xFFFF - 1;  // 一段
+    s |= static_cast<Score>(t_digits) << 32;
+    if (converted) s += 1ULL << 16;
+    if (converted && t_digits > 0) s += 1ULL << 48;
+    return s;
+}
+
+inline Converter::Score Converter::combineScore(Score a, Score b)
+{
+    Score digits = std::max(a & kTDigitsMask, b & kTDigitsMask);
+    return (a & ~kTDigitsMask) + (b & ~kTDigitsMask) - kEmptyScore + digits;
+}
+
+inline Converter::Score Converter::joinScore(Score a, bool a_raw_end, Score b, bool b_extends)
+{
+    return b_extends && !a_raw_end ? kNoScore : combineScore(a, b);
+}
+
+inline std::u32string_view Converter::valueText(uint32_t value_id) const
+{
+    if (value_id & kPassThroughBit)
+        return pass_values_[value_id & ~kPassThroughBit];
+    return dict_->valueText(value_id);
+}
+
+inline void Converter::resetLattice()
+{
+    code_.clear();
+    lattice_.clear();
+    lattice_arena_.reset();
+    pass_values_.clear();
+    value_hashes_.clear();
+    lattice_.emplace_back();
+    if (beam_width_ > 0) lattice_[0].beam.push_back({kEmptyScore, nullptr, false});
+    lattice_[0].arena_mark = lattice_arena_.mark();
+    lattice_generation_ = dict_ ? dict_->generation() : 0;
+    tones_ = dict_ && std::any_of(dict_->layers().begin(), dict_->layers().end(),
+                                  [](const Dictionary::Layer& l) { return tone_is_scheme(l.name); });
+    resetSearch();
+}
+
+inline void Converter::resetSearch()
+{
+    search_.reset();
+}
+
+inline void Converter::setHistory(const UserHistory* history)
+{
+    history_ = history;
+    resetSearch();
+}
+
+inline void Converter::setBeamWidth(size_t width)
+{
+    if (width == beam_width_)
+        return;
+    std::string code = std::move(code_);
+    beam_width_ = width;
+    resetLattice();  // 束只在建列时算
+    assign(code);
+}
+
+inline void Converter::setDictionary(const Dictionary* dict)
+{
+    if (dict == dict_)
+        return;
+    std::string code = std::move(code_);
+    dict_ = dict;
+    resetLattice();
+    assign(code);
+}
+
+// 相邻两次输入码通常只差末尾一个字符，只增删几列；字典重载后整个重建
+inline void Converter::assign(std::string_view code)
+{
+    if (!dict_) {
+        code_.assign(code.data(), code.size());
+        return;
+    }
+    if (lattice_generation_ != dict_->generation())
+        resetLattice();
+
+    size_t keep = 0;
+    const size_t limit = std::min(code_.size(), code.size());
+    while (keep < limit && code_[keep] == code[keep]) ++keep;
+    if (keep == code_.size() && keep == code.size())
+        return;  // 没变（Engine 每次取候选前都会调用）
+
+    SCRIPA_TRACE_SCOPE(Lattice);
+
+    if (keep < code_.size()) {
+        lattice_arena_.rewind(lattice_[keep + 1].arena_mark);
+        pass_values_.resize(lattice_[keep + 1].pass_mark);
+        code_.resize(keep);
+        lattice_.resize(keep + 1);
+        resetSearch();
+    }
+    for (size_t j = keep; j < code.size(); ++j) {
+        if (interrupted())
+            return;  // code_ 仍与已建的列一致，下次从这里接着建
+        code_.push_back(code[j]);
+        appendColumn(j + 1);
+    }
+}
+
+// Lattice: node j = first j chars consumed, edge [i, j) = one value for that part
+inline void Converter::appendColumn(size_t j)
+{
+    const char c = code_[j - 1];
+    LatticeColumn col;
+    col.arena_mark = lattice_arena_.mark();
+    col.pass_mark = pass_values_.size();
+
+    // 调号 T[1-5]+ 建列时认出：中间的位置不作段的起点，整段只有一条生成的边（没启用 tones 时只记 T 的位置）
+    if (c == 'T')
+        col.tone_start = static_cast<uint32_t>(j - 1);
+    else if (tone_is_digit(c))
+        col.tone_start = lattice_[j - 1].tone_start;
+    auto insideTone = [&](size_t i) {
+        const LatticeColumn& at = i + 1 == j ? col : lattice_[i + 1];  // 第 i 个字符所在的列
+        return tones_ && at.tone_start != kNoTone && at.tone_start < i;
+    };
+
+    auto textHash = [](std::u32string_view value) {
+        std::pair<uint64_t, uint64_t> h{0, 1};
+        for (char32_t ch : value) {
+            h.first = h.first * kTextHashBase + ch;
+            h.second *= kTextHashBase;
+        }
+        return h;
+    };
+
+    // 只延长仍是某个键前缀的段，走不下去的分支直接剪掉
+    auto advance = [&](size_t from, Dictionary::TrieNodeId node) {
+        Dictionary::TrieNodeId next = dict_->TrieStep(node, c);
+        if (next == Dictionary::kNoTrieNode) return;
+        col.open.push_back({from, next});
+        ValueSpan values = dict_->TrieValues(next);
+        if (values.empty()) return;
+        // T 位数与是否原样输出都是加载时算好的，这里不再转码比较；文本哈希按驻留编号只算一次
+        for (const DictEntry& v : values) {
+            if (value_hashes_.size() <= v.value_id) value_hashes_.resize(dict_->valueCount(), {0, 0});
+            auto& h = value_hashes_[v.value_id];
+            if (h.second == 0) h = textHash(v.value);
+            col.edges.push_back({static_cast<uint32_t>(from), v.value_id, edgeScore(values.tDigits(), !v.identity),
+                                 h.first, h.second, false, false});
+        }
+    };
+    for (const auto& o : lattice_[j - 1].open) advance(o.first, o.second);
+    if (!insideTone(j - 1)) advance(j - 1, Dictionary::kTrieRoot);
+
+    auto passThrough = [&](size_t from, std::u32string_view value, Score score, bool raw, bool extends) {
+        auto h = textHash(value);
+        uint32_t id = static_cast<uint32_t>(pass_values_.size()) | kPassThroughBit;
+        pass_values_.push_back(value);
+        col.edges.push_back({static_cast<uint32_t>(from), id, score, h.first, h.second, raw, extends});
+    };
+    auto widen = [&](std::string_view part) {
+        auto* buf = static_cast<char32_t*>(lattice_arena_.allocate(part.size() * sizeof(char32_t), alignof(char32_t)));
+        return std::u32string_view(buf, utf8_to_utf32(part, buf));
+    };
+
+    // 调号 [tone_start, j) 是整段的一条边，调符由 tone_letters 生成；字库里同一段若有同样的值就不重复加
+    const bool tone_edge = tones_ && col.tone_start != kNoTone && col.tone_start + 1 < j;
+    if (tone_edge) {
+        const size_t from = col.tone_start;
+        std::string_view digits(code_.data() + from + 1, j - from - 1);
+        auto* buf = static_cast<char32_t*>(lattice_arena_.allocate(digits.size() * sizeof(char32_t), alignof(char32_t)));
+        std::u32string_view value(buf, tone_letters(digits, buf));
+        bool listed = std::any_of(col.edges.begin(), col.edges.end(), [&](const LatticeEdge& e) {
+            return e.from == from && valueText(e.value_id) == value;
+        });
+        if (!listed) passThrough(from, value, edgeScore(static_cast<int>(digits.size()), true), false, false);
+    }
+
+    // 原样输出：还可能是键的段各一条边（起点在 col.pieces），走出之后起一个长段，后面逐字符续写、不另算段
+    size_t pass_from = j - 1;
+    while (pass_from > 0 && j - pass_from < 4 && (static_cast<unsigned char>(code_[pass_from]) & 0xC0) == 0x80) --pass_from;
+    const unsigned char lead = static_cast<unsigned char>(code_[pass_from]);
+    const size_t char_len = (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 : (lead >> 3) == 0x1E ? 4 : 1;
+    const bool char_end = j - pass_from >= char_len;
+    auto pieceFrom = [&](size_t from) {
+        if (insideTone(from)) return;
+        auto node = std::find_if(col.open.begin(), col.open.end(), [&](const auto& o) { return o.first == from; });
+        const bool long_piece = node == col.open.end() && col.tone_start != from && char_end;
+        std::string_view part(code_.data() + from, j - from);
+        std::u32string_view value = widen(part);
+        const Score score = edgeScore(Dictionary::tDigitCount(part), !utf32_equals_utf8(value, part));
+        if (long_piece) {
+            passThrough(from, value, score, true, false);
+            return;
+        }
+        col.pieces.push_back(static_cast<uint32_t>(from));
+        const bool matched = (node != col.open.end() && !dict_->TrieValues(node->second).empty()) ||
+                             (tone_edge && col.tone_start == from);
+        if (!matched) passThrough(from, value, score, false, false);
+    };
+    for (uint32_t from : lattice_[j - 1].pieces) pieceFrom(from);
+    pieceFrom(j - 1);
+    passThrough(j - 1, char_end ? widen(std::string_view(code_.data() + pass_from, j - pass_from)) : std::u32string_view(),
+                kEmptyScore, true, true);
+
+    if (beam_width_ > 0) extendBeam(col);
+    lattice_.push_back(std::move(col));
+    resetSearch();
+}
+
+// 每条边接上起点那一列束里的每个前缀，取前 beam_width_ 个文本不同的（同分按码点序）
+inline void Converter::extendBeam(LatticeColumn& col)
+{
+    beam_scratch_.clear();
+    for (const auto& e : col.edges) {
+        const uint32_t len = static_cast<uint32_t>(valueText(e.value_id).size());
+        for (const BeamItem& prev : lattice_[e.from].beam) {
+            const uint64_t hash = prev.path ? prev.path->hash * e.scale + e.hash : e.hash;
+            const uint32_t length = (prev.path ? prev.path->length : 0) + len;
+            const Score score = joinScore(prev.score, prev.raw_end, e.score, e.extends);
+            if (score == kNoScore) continue;
+            beam_scratch_.push_back({score, hash, length, &prev, &e});
+        }
+    }
+    {
+        SCRIPA_TRACE_SCOPE(Sort);
+        std::sort(beam_scratch_.begin(), beam_scratch_.end(), [this](const BeamCandidate& a, const BeamCandidate& b) {
+            if (a.score != b.score) return a.score > b.score;
+            return compareText(a.prev->path, valueText(a.edge->value_id), b.prev->path, valueText(b.edge->value_id)) < 0;
+        });
+    }
+    SCRIPA_TRACE_TOTAL(dedup_time, Dedup);
+    for (const auto& c : beam_scratch_) {
+        if (col.beam.size() == beam_width_)
+            break;
+        {
+            SCRIPA_TRACE_PART(dedup_time);
+            bool seen = std::any_of(col.beam.begin(), col.beam.end(), [&](const BeamItem& item) {
+                return (item.path ? item.path->hash : 0) == c.hash && (item.path ? item.path->length : 0) == c.length;
+            });
+            if (seen)
+                continue;
+        }
+        const PrefixNode* path = c.prev->path;
+        if (c.length != (path ? path->length : 0))  // 空值不占节点
+            path = lattice_arena_.create<PrefixNode>(c.edge->value_id, c.length, path, c.hash);
+        col.beam.push_back({c.score, path, c.edge->raw});
+    }
+}
+
+inline std::u32string Converter::materialize(const PrefixNode* path) const
+{
+    std::u32string out(path ? path->length : 0, U'\0');
+    for (; path; path = path->prev) {
+        std::u32string_view v = valueText(path->value_id);
+        std::copy(v.begin(), v.end(), out.begin() + (path->length - v.size()));
+    }
+    return out;
+}
+
+inline const Converter::PrefixNode* Converter::appendPath(const PrefixNode* prefix, const LatticeEdge& e)
+{
+    std::u32string_view v = valueText(e.value_id);
+    if (v.empty())
+        return prefix;
+    const uint32_t plen = prefix ? prefix->length : 0;
+    const char32_t* head = plen >= kHeadLength ? prefix->head : nullptr;
+    if (!head) {
+        auto* buf = static_cast<char32_t*>(search_arena_.allocate(kHeadLength * sizeof(char32_t), alignof(char32_t)));
+        if (plen) std::copy(prefix->head, prefix->head + plen, buf);
+        std::copy(v.begin(), v.begin() + std::min<size_t>(v.size(), kHeadLength - plen), buf + plen);
+        head = buf;
+    }
+    return search_arena_.create<PrefixNode>(e.value_id, static_cast<uint32_t>(plen + v.size()), prefix,
+                                            prefix ? prefix->hash * e.scale + e.hash : e.hash, head);
+}
+
+inline int Converter::compareText(const PrefixNode* a, std::u32string_view a_tail,
+                                  const PrefixNode* b, std::u32string_view b_tail) const
+{
+    if (a && b && a->head && b->head && a_tail.empty() && b_tail.empty()) {
+        const uint32_t n = std::min({a->length, b->length, kHeadLength});
+        for (uint32_t k = 0; k < n; ++k) {
+            if (a->head[k] != b->head[k]) return a->head[k] < b->head[k] ? -1 : 1;
+        }
+        if (n < kHeadLength)  // 短的一边整段都比完了
+            return a->length == b->length ? 0 : a->length < b->length ? -1 : 1;
+    }
+    // 长的一边往回退到共用节点，记下各自最后经过的一段，通常比它就分出先后
+    const PrefixNode* x = a;
+    const PrefixNode* y = b;
+    const PrefixNode* xa = nullptr;
+    const PrefixNode* yb = nullptr;
+    while (x != y) {
+        const uint32_t lx = x ? x->length : 0, ly = y ? y->length : 0;
+        if (lx >= ly) { xa = x; x = x->prev; }
+        if (ly >= lx) { yb = y; y = y->prev; }
+    }
+    {
+        std::u32string_view pa = xa ? valueText(xa->value_id) : a_tail;
+        std::u32string_view pb = yb ? valueText(yb->value_id) : b_tail;
+        const size_t n = std::min(pa.size(), pb.size());
+        for (size_t k = 0; k < n; ++k) {
+            if (pa[k] != pb[k]) return pa[k] < pb[k] ? -1 : 1;
+        }
+        if (pa.empty() || pb.empty())  // 节点的值都不空：一边到头了，另一边也到头才相等
+            return (pa.empty() ? 0 : 1) - (pb.empty() ? 0 : 1);
+    }
+
+    // 第一段分不出来（一段是另一段的开头）：把两边共用节点之后的各段都取出来逐字比
+    auto& sa = compare_segments_[0];
+    auto& sb = compare_segments_[1];
+    sa.clear();
+    sb.clear();
+    sa.push_back(a_tail);
+    sb.push_back(b_tail);
+    for (; a != x; a = a->prev) sa.push_back(valueText(a->value_id));
+    for (; b != x; b = b->prev) sb.push_back(valueText(b->value_id));
+    std::u32string_view pa, pb;
+    for (;;) {
+        while (pa.empty() && !sa.empty()) { pa = sa.back(); sa.pop_back(); }
+        while (pb.empty() && !sb.empty()) { pb = sb.back(); sb.pop_back(); }
+        if (pa.empty() || pb.empty())
+            return (pa.empty() ? 0 : 1) - (pb.empty() ? 0 : 1);
+        size_t n = std::min(pa.size(), pb.size());
+        for (size_t k = 0; k < n; ++k) {
+            if (pa[k] != pb[k]) return pa[k] < pb[k] ? -1 : 1;
+        }
+        pa.remove_prefix(n);
+        pb.remove_prefix(n);
+    }
+}
+
+inline bool Converter::textEqual(const PrefixNode* a, const PrefixNode* b) const
+{
+    if (a == b) return true;
+    if ((a ? a->length : 0) != (b ? b->length : 0)) return false;
+    if ((a ? a->hash : 0) != (b ? b->hash : 0)) return false;
+    return compareText(a, b) == 0;
+}
+
+// 精确搜索的上界：从末尾反向 DP，按 (T 位数, 是否以续写开头) 分状态；顺带把边按起点归好
+inline void Converter::prepareSearch()
+{
+    const size_t n = lattice_.size() - 1;
+    search_columns_.resize(n + 1);
+    for (auto& sc : search_columns_) {
+        sc.suffix_best.clear();
+        sc.out.clear();
+    }
+    search_columns_[n].suffix_best.push_back(kEmptyScore);
+    for (size_t j = n; j > 0; --j) {
+        const auto& suffixes = search_columns_[j].suffix_best;
+        for (const auto& e : lattice_[j].edges) {
+            SearchColumn& from = search_columns_[e.from];
+            from.out.push_back({static_cast<uint32_t>(j), &e});
+            for (size_t k = 0; k < suffixes.size(); ++k) {
+                if (suffixes[k] == kNoScore) continue;
+                Score s = joinScore(e.score, e.raw, suffixes[k], k & 1);
+                if (s == kNoScore) continue;
+                const size_t state = static_cast<size_t>(tDigitsOf(s)) * 2 + e.extends;
+                if (from.suffix_best.size() <= state) from.suffix_best.resize(state + 1, kNoScore);
+                if (s > from.suffix_best[state]) from.suffix_best[state] = s;
+            }
+        }
+    }
+}
+
+// 前缀 + 最优后缀 = 该前缀能达到的最好完整得分（精确上界）；kNoScore 表示从 pos 走不到末尾（如多字节字符中间）
+inline Converter::Score Converter::bestCompletion(size_t pos, Score prefix, bool raw_end) const
+{
+    Score top = kNoScore;
+    const auto& suffixes = search_columns_[pos].suffix_best;
+    for (size_t k = 0; k < suffixes.size(); ++k) {
+        if (suffixes[k] == kNoScore) continue;
+        top = std::max(top, joinScore(prefix, raw_end, suffixes[k], k & 1));
+    }
+    return top;
+}
+
+// Best-first search under the backward-DP bound: pops candidates in ranking order, ties in code-point order
+inline void Converter::produceCandidates(size_t count)
+{
+    if (beam_width_ > 0) {
+        produceBeamCandidates();
+        return;
+    }
+    const size_t n = lattice_.size() - 1;  // input length
+    if (!search_) {
+        search_arena_.reset();
+        search_.emplace(this, &search_arena_);
+        prepareSearch();
+        search_->queue.push({0, kEmptyScore, bestCompletion(0, kEmptyScore, false), nullptr, false});
+        if (history_) pinLearned();
+    }
+    CandidateSearch& st = *search_;
+    SCRIPA_TRACE_TOTAL(sort_time, Sort);
+    SCRIPA_TRACE_TOTAL(dedup_time, Dedup);
+
+    while (st.results.size() < count && !interrupted()) {
+        Partial cur;
+        {
+            SCRIPA_TRACE_PART(sort_time);
+            if (st.lane) {
+                cur = *st.lane;
+                st.lane.reset();
+            } else {
+                if (st.ties.empty()) {
+                    if (st.queue.empty())
+                        break;
+                    st.tie_bound = st.queue.top().bound;
+                    for (; !st.queue.empty() && st.queue.top().bound == st.tie_bound; st.queue.pop())
+                        st.ties.push(st.queue.top());
+                }
+                cur = st.ties.top();
+                st.ties.pop();
+            }
+        }
+
+        // 同一位置、同一状态（T 位数、是否以原样输出结尾）、同一前缀文本：先弹出者得分不低，后来者可丢弃
+        {
+            SCRIPA_TRACE_PART(dedup_time);
+            const uint32_t state = static_cast<uint32_t>(tDigitsOf(cur.score)) * 2 + cur.raw_end;
+            if (!st.expanded.insert({cur.pos, state, cur.path}).second)
+                continue;
+        }
+
+        if (cur.pos == n) {
+            std::u32string text = materialize(cur.path);
+            SCRIPA_TRACE_PART(dedup_time);
+            emit(std::move(text));
+            continue;
+        }
+
+        // 兄弟里文本最小的一条通常就是下一个：比 ties 的堆顶还小就直接接着处理，不进堆
+        std::optional<Partial> first;
+        std::u32string_view first_value;
+        for (const auto& [to, e] : search_columns_[cur.pos].out) {
+            if (cur.raw_end && !e->extends && e->score == kPlainScore)
+                continue;  // 接着续写拼出的文本相同，还少一段
+            Score score = joinScore(cur.score, cur.raw_end, e->score, e->extends);
+            if (score == kNoScore)
+                continue;
+            Score bound = bestCompletion(to, score, e->raw);
+            if (bound == kNoScore)
+                continue;
+            Partial child{to, score, bound, appendPath(cur.path, *e), e->raw};
+            SCRIPA_TRACE_PART(sort_time);
+            if (bound != st.tie_bound) {
+                st.queue.push(child);
+                continue;
+            }
+            std::u32string_view value = valueText(e->value_id);
+            if (!first || value < first_value) {
+                if (first) st.ties.push(*first);
+                first = child;
+                first_value = value;
+            } else {
+                st.ties.push(child);
+            }
+        }
+        if (first) {
+            SCRIPA_TRACE_PART(sort_time);
+            if (st.ties.empty() || !st.text_greater(*first, st.ties.top()))
+                st.lane = first;
+            else
+                st.ties.push(*first);
+        }
+    }
+}
+
+inline void Converter::emit(std::u32string text)
+{
+    CandidateSearch& st = *search_;
+    if (st.emitted.insert(search_arena_.copy(text)).second)
+        st.results.push_back(std::move(text));
+}
+
+// 束里的前缀一次全部产出，选词记录里的在前
+inline void Converter::produceBeamCandidates()
+{
+    if (search_)
+        return;
+    search_arena_.reset();
+    search_.emplace(this, &search_arena_);
+    if (history_) pinLearned();
+    auto& results = search_->results;
+    const size_t pinned = results.size();
+
+    std::vector<std::pair<Score, std::u32string>> ranked;
+    for (const BeamItem& item : lattice_.back().beam)
+        ranked.push_back({item.score, materialize(item.path)});
+    {
+        SCRIPA_TRACE_SCOPE(Sort);
+        std::sort(ranked.begin(), ranked.end(), [](const auto& a, const auto& b) {
+            return a.first != b.first ? a.first > b.first : a.second < b.second;
+        });
+    }
+    for (auto& r : ranked) {
+        if (std::find(results.begin(), results.begin() + pinned, r.second) == results.begin() + pinned)
+            results.push_back(std::move(r.second));
+    }
+}
+
+// 选过的候选还拼得出来才提前；先放进 emitted，结构搜索再拼出同一文本时跳过
+inline void Converter::pinLearned()
+{
+    CandidateSearch& st = *search_;
+    st.history_version = history_->version();
+    const size_t n = lattice_.size() - 1;
+    for (const auto& entry : history_->lookup(code_)) {
+        if (entry.text.empty()) continue;
+        dead_.assign((n + 1) * (entry.text.size() + 1) * 2, 0);
+        if (matchText(n, entry.text.size(), entry.text, false))
+            emit(entry.text);
+    }
+}
+
+inline bool Converter::matchText(size_t pos, size_t end, std::u32string_view text, bool raw_end)
+{
+    if (pos == 0)
+        return end == 0 && !raw_end;
+    char& dead = dead_[(pos * (text.size() + 1) + end) * 2 + raw_end];
+    if (dead)
+        return false;
+    for (const auto& e : lattice_[pos].edges) {
+        if (raw_end && !e.raw) continue;
+        std::u32string_view v = valueText(e.value_id);
+        if (v.size() > end || text.substr(end - v.size(), v.size()) != v) continue;
+        if (matchText(e.from, end - v.size(), text, e.extends))
+            return true;
+    }
+    dead = 1;
+    return false;
+}
+
+inline std::vector<std::u32string> Converter::candidates(size_t k, size_t offset)
+{
+    if (!dict_)
+        return {};
+
+    if (lattice_generation_ != dict_->generation()) {
+        std::string code = code_;
+        resetLattice();
+        assign(code);
+    }
+    if (search_ && history_ && search_->history_version != history_->version())
+        resetSearch();  // 刚记了一次选词
+    if (lattice_.size() <= 1 || k == 0 || interrupted())
+        return {};
+
+    SCRIPA_TRACE_SCOPE(Search);
+    const size_t want = offset + std::min(k, SIZE_MAX - offset);
+    produceCandidates(want);
+    if (interrupted())
+        return {};  // 只搜了一部分，不能当作全部候选
+
+    const auto& results = search_->results;
+    if (offset >= results.size())
+        return {};
+    size_t end = std::min(results.size(), want);
+    return std::vector<std::u32string>(results.begin() + offset, results.begin() + end);
+}
+
+inline std::vector<std::u32string> Converter::convert(const Dictionary& dict, std::string_view code, size_t k)
+{
+    Converter conv(&dict);
+    conv.assign(code);
+    return conv.candidates(k);
+}
+
+// 每个线程一个 Converter，按块领取下标；相邻输入码的公共前缀复用词格
+inline std::vector<std::vector<std::u32string>> Converter::convertBatch(const Dictionary& dict,
+    const std::vector<std::string_view>& codes, size_t k, unsigned threads, size_t beam_width)
+{
+    std::vector<std::vector<std::u32string>> results(codes.size());
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    const size_t chunk = 64;
+    const size_t chunks = (codes.size() + chunk - 1) / chunk;
+    threads = static_cast<unsigned>(std::min<size_t>(threads, chunks));
+
+    std::atomic<size_t> next{0};
+    auto work = [&]() {
+        Converter conv(&dict);
+        conv.setBeamWidth(beam_width);
+        for (size_t c = next.fetch_add(1); c < chunks; c = next.fetch_add(1)) {
+            const size_t end = std::min(codes.size(), (c + 1) * chunk);
+            for (size_t i = c * chunk; i < end; ++i) {
+                conv.assign(codes[i]);
+                results[i] = conv.candidates(k);
+            }
+        }
+    };
+
+    if (threads <= 1) {
+        work();
+        return results;
+    }
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(work);
+    work();
+    for (auto& th : pool) th.join();
+    return results;
+}
@@ -7,69 +7,275 @@
 #include <iostream>
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
+#include <string_view>
+#include <memory>
+#include <atomic>
+#include "SchemeImage.hpp"
+#include "Utf.hpp"
 
-static std::u32string utf8_to_utf32(const std::string& utf8) //把8位变成32位
-{
-    std::u32string out;
-    size_t i = 0, n = utf8.size();
+// 字典里的一条候选：文本在驻留池里只存一份，其余是加载时算好的元数据，排名时直接读整数
+struct DictEntry {
+    std::u32string_view value;  // 驻留的值文本
+    uint32_t value_id;          // 驻留编号：文本相同的值编号相同
+    uint32_t length;            // 码点数
+    bool identity;              // 值编码成 UTF-8 后就是键本身（原样输出，不算转换）
+};
 
-    while (i < n) {
-        unsigned char c = utf8[i];
-        char32_t code = 0;
-        size_t extra = 0;
+// 某个键的全部候选：直接指向字典内部，不复制字符串。字典重载或清空之前有效
+class ValueSpan {
+public:
+    ValueSpan() = default;
+    ValueSpan(const DictEntry* data, size_t size, int t_digits) : data_(data), size_(size), t_digits_(t_digits) {}
 
-        if (c < 0x80) {
-            code = c;
-            extra = 0;
-        }
-        else if ((c >> 5) == 0x6) { // 110xxxxx
-            code = c & 0x1F;
-            extra = 1;
-        }
-        else if ((c >> 4) == 0xE) { // 1110xxxx
-            code = c & 0x0F;
-            extra = 2;
-        }
-        else if ((c >> 3) == 0x1E) { // 11110xxx
-            code = c & 0x07;
-            extra = 3;
-        }
-        else {
-            // invalid byte
-            ++i;
-            continue;
-        }
+    const DictEntry* begin() const { return data_; }
+    const DictEntry* end() const { return data_ + size_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    const DictEntry& operator[](size_t i) const { return data_[i]; }
+    int tDigits() const { return t_digits_; } // 键的 T-pattern 位数（加载时算好）
+
+private:
+    const DictEntry* data_ = nullptr;
+    size_t size_ = 0;
+    int t_digits_ = 0;
+};
 
-        if (i + extra >= n) break;
+// 编进程序的字库表（gen_builtin_schemes 生成）：全是常量，前缀树节点用最小完美哈希定位
+struct StaticSchemes {
+    struct Scheme {
+        std::string_view name;
+        uint64_t source_size;  // 生成时源 .txt 的字节数（仅供查看）
+        uint64_t source_hash;  // 源 .txt 的 fingerprint；目录里的文件与它不同就不用这一节
+    };
+    struct Node {
+        uint64_t hash;     // 前缀的哈希：prefixHash(父节点的 hash, byte)，根为 kRootHash
+        uint64_t schemes;  // 以此为前缀的键出自哪几节（按节号的位掩码），查询时只走还有已启用字库的分支
+        uint32_t parent;
+        uint32_t key_begin;  // keys 下标：以此节点为完整键的各字库记录
+        uint8_t key_count;   // 0 表示不是完整键；大于 1 表示几个字库都有这个键
+        unsigned char byte;
+    };
+    struct Key {
+        std::string_view text;
+        uint32_t scheme;       // schemes 下标
+        uint32_t value_begin;  // entries 下标：该字库里这个键的候选，按文件里的顺序、已去重
+        uint32_t value_count;
+        int t_digits;          // Dictionary::tDigitCount(text)
+    };
 
-        for (size_t j = 1; j <= extra; ++j) {
-            unsigned char cc = utf8[i + j];
-            code = (code << 6) | (cc & 0x3F);
-        }
+    const Scheme* schemes;
+    size_t scheme_count;
+    const Node* nodes;  // nodes[0] 为根；其余节点的编号 = 槽位 + 1
+    size_t node_count;
+    const uint32_t* displacements;
+    size_t bucket_count;
+    const Key* keys;  // 按文本排序，同一个键的各字库记录相邻
+    size_t key_count;
+    const DictEntry* entries;
+    size_t entry_count;
+    const std::u32string_view* values;  // 按码点排序，下标就是驻留编号
+    size_t value_count;
+    const uint32_t* shared_keys;  // 几个字库都有的键（keys 下标，各取第一条），合并时要按查找链现场排
+    size_t shared_count;
 
-        out.push_back(code);
-        i += extra + 1;
-    }
-    return out;
-}
+    static constexpr uint32_t kRoot = 0;
+    static constexpr uint64_t kRootHash = 0x5C819A0000000000ull;
+    static constexpr uint32_t kNoNode = UINT32_MAX;
+    static constexpr uint32_t kNoValue = UINT32_MAX;
+    static constexpr size_t kMaxSchemes = 64;  // Dictionary 用一个 64 位掩码记启用了哪几节
+
+    int findScheme(std::string_view name) const; // 找不到返回 -1
+    uint32_t step(uint32_t node, char c) const;  // 前进一个字节，O(1)
+    uint32_t findNode(std::string_view key) const;
+    uint32_t findValue(std::u32string_view text) const; // 值表里二分查找
+
+    // 生成器与查表共用。前缀哈希的高 32 位选桶，低 32 位和桶的位移一起选槽位，都不用除法
+    static uint64_t prefixHash(uint64_t parent, unsigned char c);
+    static uint32_t bucketOf(uint64_t prefix, size_t buckets);
+    static uint32_t slotOf(uint64_t prefix, uint32_t displacement, size_t slots);
+    // 源文件内容的 FNV-1a，忽略 '\r'（换行风格不同不算改过）
+    static uint64_t fingerprint(std::string_view bytes);
+};
 
 // 字典类 Dictionary class
 class Dictionary {
 public:
-    bool load(const std::string& path); // 加载 scheme 文件
-    std::vector<std::u32string> Lookup(const std::string& key) const; // 返回当前 key 的所有候选
-    std::vector<std::u32string> LookupByPrefix(const std::string& prefix) const;
+    // 前缀树节点编号：从 kTrieRoot 出发逐字节前进，kNoTrieNode 表示没有任何键以此为前缀
+    using TrieNodeId = uint32_t;
+    static constexpr TrieNodeId kTrieRoot = 0;
+    static constexpr TrieNodeId kNoTrieNode = UINT32_MAX;
+
+    // 字库层：镜像或编进程序的表里的一节，加载后不变；按优先级排成查找链，同一个键的候选按层的顺序排
+    struct Layer {
+        std::string name;
+        int priority = 0;                          // 大者在前；相同时先加入的在前
+        std::shared_ptr<const SchemeImage> image;  // 层存活期间值池有效
+        size_t scheme = 0;                         // image（或 builtin）里的第几节
+        std::string origin;                        // 由哪个字库目录加载（SchemeLoader 据此同步），单独加载的为空
+        const StaticSchemes* builtin = nullptr;    // 不为空时这一层直接查编进程序的表，不用 image；各层须用同一份表
+    };
+
+    Dictionary() = default;
+    Dictionary(const Dictionary&) = delete; // 值文本指向各层的镜像；要复制就用 setLayers(other.layers())
+    Dictionary& operator=(const Dictionary&) = delete;
+
+    bool load(const std::string& path); // 加载 scheme 文本文件（现场编译成内存镜像）
+    bool loadScheme(const std::shared_ptr<const SchemeImage>& image, size_t scheme); // 从编译好的镜像加载一节（优先级 0 的一层），不解析文本
+    bool addLayer(Layer layer); // 加入一层（同名的层被替换）；排在最后时直接并入，否则重建合并索引
+    bool removeLayer(std::string_view name); // 移除一层，其余层不重新加载
+    void setLayers(std::vector<Layer> layers); // 整体换成这些层，只建一次合并索引
+    const std::vector<Layer>& layers() const { return layers_; } // 查找链，优先级从高到低
+    static bool parseSchemeText(const std::string& path, SchemeImageBuilder& out); // 解析 scheme 文本，逐条加入 out
+    ValueSpan Lookup(std::string_view key) const; // 返回当前 key 的所有候选（视图，不分配）；key 可以直接是 buffer 的子串
+    std::vector<std::u32string> LookupByPrefix(std::string_view prefix) const;
+    bool HasPrefix(std::string_view prefix) const; // 是否有键以 prefix 开头，O(|prefix|)
+    TrieNodeId TrieStep(TrieNodeId node, char c) const; // 前进一个字节
+    ValueSpan TrieValues(TrieNodeId node) const; // 节点是完整键时返回其候选，否则为空
+    std::u32string_view valueText(uint32_t value_id) const; // 驻留编号 -> 文本
+    size_t valueCount() const { return builtinValueCount() + values_.size(); } // 驻留的不同值个数
     void clear(); // 清空字典
     void debugPrint() const;// 调试：打印整个字典
+    uint64_t generation() const { return generation_; } // 内容每变一次换一个新值（进程内不重复，换了字典对象也不会撞上），供上层判断缓存是否过期
+
+    // Helper: get digit count in T-pattern (e.g., T132 -> 3, T1 -> 1, not T-pattern -> 0)
+    static int tDigitCount(std::string_view part);
 private:
-    std::unordered_map<std::string, std::vector<std::u32string>> dict_;
-    // key: 输入法编码（如 "th", "aa", "ts"）
-    // value: IPA 字符（UTF-32 形式） schemes
+    // 一个键合并后的候选：各层按查找链顺序排好、相同的值只留优先级最高的一份，查询时直接用这个顺序
+    struct KeyEntry {
+        std::string_view key;  // 指向最先提供它的那一层镜像的字符串池
+        std::vector<DictEntry> values;
+        int t_digits = 0;      // tDigitCount(key)
+    };
+    static constexpr uint32_t kNoEntry = UINT32_MAX;
+    struct TrieNode {
+        std::vector<std::pair<unsigned char, TrieNodeId>> children;  // 按字节升序
+        uint32_t entry = kNoEntry;                                  // entries_ 下标；不是完整键时为 kNoEntry
+        uint32_t builtin = StaticSchemes::kNoNode;                  // 编进程序的表里同一前缀的节点
+    };
+    // 只在编进程序的表里有的前缀：节点编号是表里的编号加上这一位
+    static constexpr TrieNodeId kBuiltinNodeBit = 0x80000000u;
+
+    static bool childLess(const std::pair<unsigned char, TrieNodeId>& child, unsigned char c) { return child.first < c; }
+    static bool validLayer(const Layer& layer);
+    TrieNodeId findNode(std::string_view prefix) const;
+    TrieNodeId insertTrieKey(std::string_view key); // 沿途补齐节点，返回 key 的节点
+    KeyEntry& entryFor(std::string_view key);        // 没有就新建一个空的
+    uint32_t builtinStep(uint32_t node, char c) const; // 在表里前进一个字节；往下没有已启用字库的键就当作没有
+    ValueSpan builtinValues(uint32_t node) const;    // 表里的节点：只有一个已启用的字库有这个键时直接返回表里的候选
+    size_t builtinValueCount() const { return builtin_ ? builtin_->value_count : 0; }
+    uint32_t internValue(std::u32string_view value);
+    void mergeLayer(const Layer& layer);   // 把一层的键值接到合并索引末尾
+    void mergeBuiltin(const Layer& layer); // 编进程序的一层：只接到合并索引里已有的键上，其余的键查询时直接读表
+    void rebuildIndex();                   // 按 layers_ 的顺序重建合并索引
+    static uint64_t nextGeneration();
+
+    std::vector<Layer> layers_;  // 查找链；下面是由它合并出的索引，层变了就重建
+    std::vector<KeyEntry> entries_;  // 每个键一项，按首次出现的顺序（查找链顺序 + 镜像里的键序）
+    uint64_t generation_ = 0;
+
+    // 值驻留池：文本相同的值共用一个编号，编进程序的表里的值占前 builtinValueCount() 个
+    std::unordered_map<std::u32string_view, uint32_t> value_ids_;
+    std::vector<std::u32string_view> values_;
+
+    // 查找链里编进程序的各层：用的哪份表、启用了其中哪几节（按节号的位掩码）
+    const StaticSchemes* builtin_ = nullptr;
+    uint64_t builtin_mask_ = 0;
+
+    // 输入码前缀树：完整键的节点指向 entries_；编进程序的表里的键不复制，走不下去时转到表里
+    std::vector<TrieNode> trie_ = std::vector<TrieNode>(1);
 };
 
 
+// 当前字典的发布点：load() 拿快照，publish() 换新的，旧快照随最后一个读者释放
+class SharedDictionary {
+public:
+    std::shared_ptr<const Dictionary> load() const { return std::atomic_load(&current_); }
+    void publish(std::shared_ptr<const Dictionary> dict) { std::atomic_store(&current_, std::move(dict)); }
+
+private:
+    std::shared_ptr<const Dictionary> current_;
+};
+
 //执行层
+inline int StaticSchemes::findScheme(std::string_view name) const
+{
+    for (size_t i = 0; i < scheme_count; ++i) {
+        if (schemes[i].name == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+// 每个字节只乘一次（逐字节的依赖链）；哈希互不相同由生成器检查
+inline uint64_t StaticSchemes::prefixHash(uint64_t parent, unsigned char c)
+{
+    uint64_t x = (parent ^ c) * 0x9E3779B97F4A7C15ull;
+    return x ^ (x >> 29);
+}
+
+// [0, 2^32) 均匀映射到 [0, n)：乘法取高位
+inline uint32_t StaticSchemes::bucketOf(uint64_t prefix, size_t buckets)
+{
+    return static_cast<uint32_t>(((prefix >> 32) * uint64_t(buckets)) >> 32);
+}
+
+inline uint32_t StaticSchemes::slotOf(uint64_t prefix, uint32_t displacement, size_t slots)
+{
+    uint32_t x = static_cast<uint32_t>(prefix) ^ (displacement * 0x9E3779B9u);
+    x = (x ^ (x >> 16)) * 0x85EBCA6Bu;  // murmur3 fmix32
+    x = (x ^ (x >> 13)) * 0xC2B2AE35u;
+    x ^= x >> 16;
+    return static_cast<uint32_t>((uint64_t(x) * uint64_t(slots)) >> 32);
+}
+
+inline uint32_t StaticSchemes::step(uint32_t node, char c) const
+{
+    if (node >= node_count || node_count <= 1)
+        return kNoNode;
+    const unsigned char uc = static_cast<unsigned char>(c);
+    const uint64_t prefix = prefixHash(nodes[node].hash, uc);
+    const uint32_t slot = slotOf(prefix, displacements[bucketOf(prefix, bucket_count)], node_count - 1);
+    const Node& child = nodes[slot + 1];
+    return child.parent == node && child.byte == uc ? slot + 1 : kNoNode;
+}
+
+inline uint32_t StaticSchemes::findNode(std::string_view key) const
+{
+    uint32_t node = kRoot;
+    for (char c : key) {
+        node = step(node, c);
+        if (node == kNoNode) break;
+    }
+    return node;
+}
+
+inline uint32_t StaticSchemes::findValue(std::u32string_view text) const
+{
+    const std::u32string_view* end = values + value_count;
+    const std::u32string_view* it = std::lower_bound(values, end, text);
+    return it != end && *it == text ? static_cast<uint32_t>(it - values) : kNoValue;
+}
+
+inline uint64_t StaticSchemes::fingerprint(std::string_view bytes)
+{
+    uint64_t h = 0xCBF29CE484222325ull;
+    for (char c : bytes) {
+        if (c == '\r') continue;
+        h = (h ^ static_cast<unsigned char>(c)) * 0x100000001B3ull;
+    }
+    return h;
+}
+
 inline bool Dictionary::load(const std::string& path)
+{
+    SchemeImageBuilder builder;
+    builder.beginScheme(path);
+    if (!parseSchemeText(path, builder))
+        return false;
+    return loadScheme(SchemeImage::fromBytes(builder.finish()), 0);
+}
+
+inline bool Dictionary::parseSchemeText(const std::string& path, SchemeImageBuilder& out)
 {
     std::ifstream fin(path);
     if (!fin.is_open()) {
@@ -108,7 +314,7 @@ inline bool Dictionary::load(const std::string& path)
             while (b > a && std::isspace((unsigned char)sub[b-1])) --b;
             if (a < b) {
                 std::string final_key = sub.substr(a, b - a);
-                dict_[final_key].push_back(value);
+                out.add(final_key, value);
             }
             if (q == std::string::npos) break;
             p = q + 1;
@@ -118,21 +324,197 @@ inline bool Dictionary::load(const std::string& path)
     return true;
 }
 
-inline std::vector<std::u32string> Dictionary::Lookup(const std::string& key) const
+inline bool Dictionary::loadScheme(const std::shared_ptr<const SchemeImage>& image, size_t scheme)
 {
-    auto it = dict_.find(key);
-    if (it == dict_.end())
-        return {};
+    if (!image || scheme >= image->schemeCount())
+        return false;
+    return addLayer({std::string(image->schemeName(scheme)), 0, image, scheme, {}});
+}
+
+inline bool Dictionary::validLayer(const Layer& layer)
+{
+    if (layer.builtin)
+        return layer.scheme < layer.builtin->scheme_count && layer.scheme < StaticSchemes::kMaxSchemes;
+    return layer.image && layer.scheme < layer.image->schemeCount();
+}
+
+inline bool Dictionary::addLayer(Layer layer)
+{
+    if (!validLayer(layer) || (layer.builtin && builtin_ && layer.builtin != builtin_))
+        return false;
+
+    bool replaced = false;
+    auto same = std::find_if(layers_.begin(), layers_.end(), [&](const Layer& l) { return l.name == layer.name; });
+    if (same != layers_.end()) {
+        layers_.erase(same);
+        replaced = true;
+    }
+    // 排在优先级不低于它的各层之后
+    auto pos = std::find_if(layers_.begin(), layers_.end(), [&](const Layer& l) { return l.priority < layer.priority; });
+    const bool last = pos == layers_.end();
+    pos = layers_.insert(pos, std::move(layer));
+    // 有编进程序的层时，新键要先接上表里排在前面的候选，只能重建
+    if (last && !replaced && !builtin_ && !pos->builtin)
+        mergeLayer(*pos);
+    else
+        rebuildIndex();
+    generation_ = nextGeneration();
+    return true;
+}
+
+inline bool Dictionary::removeLayer(std::string_view name)
+{
+    auto it = std::find_if(layers_.begin(), layers_.end(), [&](const Layer& l) { return l.name == name; });
+    if (it == layers_.end())
+        return false;
+    layers_.erase(it);
+    rebuildIndex();
+    generation_ = nextGeneration();
+    return true;
+}
+
+inline void Dictionary::setLayers(std::vector<Layer> layers)
+{
+    const StaticSchemes* builtin = nullptr;
+    for (const auto& l : layers) {
+        if (l.builtin && !builtin) builtin = l.builtin;
+    }
+    layers.erase(std::remove_if(layers.begin(), layers.end(),
+                                [&](const Layer& l) { return !validLayer(l) || (l.builtin && l.builtin != builtin); }),
+                 layers.end());
+    std::stable_sort(layers.begin(), layers.end(), [](const Layer& a, const Layer& b) { return a.priority > b.priority; });
+    layers_ = std::move(layers);
+    rebuildIndex();
+    generation_ = nextGeneration();
+}
+
+inline void Dictionary::rebuildIndex()
+{
+    entries_.clear();
+    trie_.assign(1, TrieNode{});
+    value_ids_.clear();
+    values_.clear();
+    builtin_ = nullptr;
+    builtin_mask_ = 0;
+    for (const auto& layer : layers_) {
+        if (!layer.builtin) continue;
+        builtin_ = layer.builtin;
+        builtin_mask_ |= uint64_t(1) << layer.scheme;
+    }
+    if (builtin_) {
+        trie_[0].builtin = StaticSchemes::kRoot;
+        // 先给要按查找链合并的键（镜像层的键、几个编进程序的字库共有的键）建好空条目
+        for (const auto& layer : layers_) {
+            if (layer.builtin) continue;
+            const SchemeImage& image = *layer.image;
+            for (auto it = image.keysBegin(layer.scheme); it != image.keysEnd(layer.scheme); ++it)
+                entryFor(image.key(*it));
+        }
+        for (size_t i = 0; i < builtin_->shared_count; ++i) {
+            const StaticSchemes::Key* rec = builtin_->keys + builtin_->shared_keys[i];
+            const std::string_view text = rec->text;
+            for (; rec != builtin_->keys + builtin_->key_count && rec->text == text; ++rec) {
+                if (builtin_mask_ >> rec->scheme & 1) {
+                    entryFor(text);
+                    break;
+                }
+            }
+        }
+    }
+    for (const auto& layer : layers_) {
+        if (layer.builtin)
+            mergeBuiltin(layer);
+        else
+            mergeLayer(layer);
+    }
+}
+
+inline Dictionary::KeyEntry& Dictionary::entryFor(std::string_view key)
+{
+    TrieNodeId node = insertTrieKey(key);
+    if (trie_[node].entry == kNoEntry) {
+        trie_[node].entry = static_cast<uint32_t>(entries_.size());
+        entries_.push_back({key, {}, tDigitCount(key)});
+    }
+    return entries_[trie_[node].entry];
+}
+
+inline void Dictionary::mergeBuiltin(const Layer& layer)
+{
+    const StaticSchemes& table = *layer.builtin;
+    for (auto& entry : entries_) {
+        uint32_t node = table.findNode(entry.key);
+        if (node == StaticSchemes::kNoNode) continue;
+        const StaticSchemes::Node& n = table.nodes[node];
+        for (uint32_t k = n.key_begin; k < n.key_begin + n.key_count; ++k) {
+            const StaticSchemes::Key& rec = table.keys[k];
+            if (rec.scheme != layer.scheme) continue;
+            for (uint32_t v = rec.value_begin; v < rec.value_begin + rec.value_count; ++v) {
+                const DictEntry& e = table.entries[v];
+                bool seen = std::any_of(entry.values.begin(), entry.values.end(),
+                                        [&](const DictEntry& x) { return x.value_id == e.value_id; });
+                if (!seen) entry.values.push_back(e);
+            }
+        }
+    }
+}
+
+inline void Dictionary::mergeLayer(const Layer& layer)
+{
+    const SchemeImage& image = *layer.image;
+    // 镜像里的键已排好序，值直接引用镜像的 UTF-32 池
+    for (auto it = image.keysBegin(layer.scheme); it != image.keysEnd(layer.scheme); ++it) {
+        std::string_view key = image.key(*it);
+        KeyEntry& entry = entryFor(key);
+        // 排在已有的（优先级更高的层）之后；同一个值已经有了就不再重复
+        for (uint32_t v = 0; v < it->value_count; ++v) {
+            std::u32string_view value = image.value(it->value_begin + v);
+            uint32_t id = internValue(value);
+            bool seen = std::any_of(entry.values.begin(), entry.values.end(),
+                                    [id](const DictEntry& e) { return e.value_id == id; });
+            if (!seen)
+                entry.values.push_back({valueText(id), id, static_cast<uint32_t>(value.size()), utf32_equals_utf8(value, key)});
+        }
+    }
+}
 
-    return it->second;  
+inline ValueSpan Dictionary::Lookup(std::string_view key) const
+{
+    TrieNodeId node = findNode(key);
+    if (node == kNoTrieNode)
+        return {};
+    return TrieValues(node);
 }
 
-inline std::vector<std::u32string> Dictionary::LookupByPrefix(const std::string& prefix) const {
+inline std::vector<std::u32string> Dictionary::LookupByPrefix(std::string_view prefix) const {
     std::vector<std::u32string> result;
 
-    for (const auto& pair : dict_) {
-        if (pair.first == prefix || pair.first.rfind(prefix, 0) == 0) {
-            result.insert(result.end(), pair.second.begin(), pair.second.end());
+    // 只遍历 prefix 下面的子树
+    TrieNodeId start = findNode(prefix);
+    if (start == kNoTrieNode)
+        return result;
+
+    std::vector<TrieNodeId> stack;
+    if (!(start & kBuiltinNodeBit)) stack.push_back(start);
+    while (!stack.empty()) {
+        const TrieNode& node = trie_[stack.back()];
+        stack.pop_back();
+        if (node.entry != kNoEntry) {
+            for (const auto& e : entries_[node.entry].values)
+                result.emplace_back(e.value);
+        }
+        for (const auto& child : node.children)
+            stack.push_back(child.second);
+    }
+    // 编进程序的表里的键按文本排好了，以 prefix 开头的是连续一段；合并过的键上面已经取过，重复的下面去掉
+    if (builtin_) {
+        const StaticSchemes::Key* end = builtin_->keys + builtin_->key_count;
+        const StaticSchemes::Key* it = std::lower_bound(builtin_->keys, end, prefix,
+            [](const StaticSchemes::Key& k, std::string_view p) { return k.text < p; });
+        for (; it != end && it->text.substr(0, prefix.size()) == prefix; ++it) {
+            if (!(builtin_mask_ >> it->scheme & 1)) continue;
+            for (uint32_t v = it->value_begin; v < it->value_begin + it->value_count; ++v)
+                result.emplace_back(builtin_->entries[v].value);
         }
     }
 
@@ -143,41 +525,165 @@ inline std::vector<std::u32string> Dictionary::LookupByPrefix(const std::string&
     return result;
 }
 
-inline void Dictionary::clear()
+inline bool Dictionary::HasPrefix(std::string_view prefix) const
 {
-    dict_.clear();
+    return findNode(prefix) != kNoTrieNode;
 }
 
-inline void Dictionary::debugPrint() const
+inline Dictionary::TrieNodeId Dictionary::TrieStep(TrieNodeId node, char c) const
 {
-    for (const auto& pair : dict_) {
-        std::cout << pair.first << " : ";
-        for (const auto &u32 : pair.second)
-            std::cout << "[UTF32 size=" << u32.size() << "] ";
-        std::cout << "\n";
+    uint32_t builtin = StaticSchemes::kNoNode;
+    if (node & kBuiltinNodeBit) {
+        // 前缀不在合并索引里，它的延长也不会在：只在表里走
+        builtin = node == kNoTrieNode || !builtin_ ? StaticSchemes::kNoNode : node & ~kBuiltinNodeBit;
+    } else {
+        if (node >= trie_.size())
+            return kNoTrieNode;
+        const auto& children = trie_[node].children;
+        unsigned char uc = static_cast<unsigned char>(c);
+        auto it = std::lower_bound(children.begin(), children.end(), uc, childLess);
+        if (it != children.end() && it->first == uc)
+            return it->second;
+        builtin = trie_[node].builtin;
     }
+    if (builtin == StaticSchemes::kNoNode)
+        return kNoTrieNode;
+    uint32_t next = builtinStep(builtin, c);
+    return next == StaticSchemes::kNoNode ? kNoTrieNode : next | kBuiltinNodeBit;
+}
+
+inline uint32_t Dictionary::builtinStep(uint32_t node, char c) const
+{
+    uint32_t next = builtin_->step(node, c);
+    if (next == StaticSchemes::kNoNode || !(builtin_->nodes[next].schemes & builtin_mask_))
+        return StaticSchemes::kNoNode;
+    return next;
 }
 
-inline static std::string utf32_to_utf8(const std::u32string& in)
-{
-    std::string out;
-    out.reserve(in.size());
-    for (char32_t cp : in) {
-        if (cp <= 0x7F) {
-            out.push_back(static_cast<char>(cp));
-        } else if (cp <= 0x7FF) {
-            out.push_back(static_cast<char>(0xC0 | ((cp >> 6) & 0x1F)));
-            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
-        } else if (cp <= 0xFFFF) {
-            out.push_back(static_cast<char>(0xE0 | ((cp >> 12) & 0x0F)));
-            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
-            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
-        } else {
-            out.push_back(static_cast<char>(0xF0 | ((cp >> 18) & 0x07)));
-            out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
-            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
-            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+inline ValueSpan Dictionary::TrieValues(TrieNodeId node) const
+{
+    if (node & kBuiltinNodeBit)
+        return node == kNoTrieNode ? ValueSpan() : builtinValues(node & ~kBuiltinNodeBit);
+    if (node >= trie_.size())
+        return {};
+    const TrieNode& n = trie_[node];
+    if (n.entry == kNoEntry)
+        return builtinValues(n.builtin);
+    const KeyEntry& e = entries_[n.entry];
+    return ValueSpan(e.values.data(), e.values.size(), e.t_digits);
+}
+
+inline ValueSpan Dictionary::builtinValues(uint32_t node) const
+{
+    // 几个字库共有的键都已合并进 entries_，这里只会遇到只属于一个字库的
+    if (!builtin_ || node == StaticSchemes::kNoNode || builtin_->nodes[node].key_count != 1)
+        return {};
+    const StaticSchemes::Key& rec = builtin_->keys[builtin_->nodes[node].key_begin];
+    if (!(builtin_mask_ >> rec.scheme & 1))
+        return {};
+    return ValueSpan(builtin_->entries + rec.value_begin, rec.value_count, rec.t_digits);
+}
+
+inline Dictionary::TrieNodeId Dictionary::findNode(std::string_view prefix) const
+{
+    TrieNodeId node = kTrieRoot;
+    for (char c : prefix) {
+        node = TrieStep(node, c);
+        if (node == kNoTrieNode) break;
+    }
+    return node;
+}
+
+inline Dictionary::TrieNodeId Dictionary::insertTrieKey(std::string_view key)
+{
+    TrieNodeId node = kTrieRoot;
+    for (char c : key) {
+        TrieNodeId next = TrieStep(node, c);
+        if (next == kNoTrieNode || (next & kBuiltinNodeBit)) {
+            const uint32_t parent_builtin = trie_[node].builtin;
+            next = static_cast<TrieNodeId>(trie_.size());
+            trie_.emplace_back();
+            if (parent_builtin != StaticSchemes::kNoNode)
+                trie_.back().builtin = builtinStep(parent_builtin, c);
+            auto& children = trie_[node].children;
+            unsigned char uc = static_cast<unsigned char>(c);
+            auto it = std::lower_bound(children.begin(), children.end(), uc, childLess);
+            children.insert(it, {uc, next});
         }
+        node = next;
+    }
+    return node;
+}
+
+inline uint32_t Dictionary::internValue(std::u32string_view value)
+{
+    // 表里已有的文本用表里的编号，与表里的候选一起查重
+    if (builtin_) {
+        uint32_t id = builtin_->findValue(value);
+        if (id != StaticSchemes::kNoValue)
+            return id;
     }
-    return out;
-}
\ No newline at end of file
+    auto it = value_ids_.find(value);
+    if (it != value_ids_.end())
+        return it->second;
+    uint32_t id = static_cast<uint32_t>(builtinValueCount() + values_.size());
+    values_.push_back(value);
+    value_ids_.emplace(value, id);
+    return id;
+}
+
+inline std::u32string_view Dictionary::valueText(uint32_t value_id) const
+{
+    const size_t base = builtinValueCount();
+    return value_id < base ? builtin_->values[value_id] : values_[value_id - base];
+}
+
+inline uint64_t Dictionary::nextGeneration()
+{
+    static std::atomic<uint64_t> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+inline int Dictionary::tDigitCount(std::string_view part)
+{
+    if (part.empty() || part[0] != 'T') return 0;
+    size_t i = 1;
+    int count = 0;
+    while (i < part.size() && part[i] >= '1' && part[i] <= '5') {
+        count++;
+        i++;
+    }
+    if (count == 0) return 0;  // no digits after T
+    if (i == part.size() || part[i] == 'T') return count;  // valid T-pattern
+    return 0;  // invalid
+}
+
+inline void Dictionary::clear()
+{
+    layers_.clear();
+    rebuildIndex();
+    generation_ = nextGeneration();
+}
+
+inline void Dictionary::debugPrint() const
+{
+    auto print = [](std::string_view key, const DictEntry* begin, const DictEntry* end) {
+        std::cout << key << " : ";
+        for (const DictEntry* e = begin; e != end; ++e)
+            std::cout << "[UTF32 size=" << e->length << " id=" << e->value_id << (e->identity ? " identity" : "") << "] ";
+        std::cout << "\n";
+    };
+    for (const auto& entry : entries_)
+        print(entry.key, entry.values.data(), entry.values.data() + entry.values.size());
+    if (!builtin_)
+        return;
+    // 编进程序的表里没有合并过的键
+    for (size_t i = 0; i < builtin_->key_count; ++i) {
+        const StaticSchemes::Key& rec = builtin_->keys[i];
+        uint32_t node = builtin_->findNode(rec.text);
+        if (builtin_->nodes[node].key_count != 1 || !(builtin_mask_ >> rec.scheme & 1)) continue;
+        TrieNodeId merged = findNode(rec.text);
+        if (!(merged & kBuiltinNodeBit) && trie_[merged].entry != kNoEntry) continue;
+        print(rec.text, builtin_->entries + rec.value_begin, builtin_->entries + rec.value_begin + rec.value_count);
+    }
+}
@@ -1,18 +1,10 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <vector>
-#include <unordered_map>
-#include <functional>
 #include <cstddef>
-#include <algorithm>
-#include "Dic.hpp"
-#ifdef max
-#undef max
-#endif
-#ifdef min
-#undef min
-#endif
-//maxmin宏污染
+#include <cstdint>
+#include "Converter.hpp"
 
 class Engine {
 public:
@@ -21,33 +13,91 @@ public:
         IPA
     };
     
-    explicit Engine(Dictionary* dict);
+    explicit Engine(const Dictionary* dict);
+    void setDictionary(const Dictionary* dict); //换一份字典（热重载），输入中的 buffer 保留
+    void setHistory(UserHistory* history); //选词记录：chooseCandidate 记进去，排名参考它
+    void setBeamWidth(size_t width); //束搜索宽度，0 为精确搜索（取舍见 Converter::setBeamWidth）
+    size_t beamWidth() const { return conv_.beamWidth(); }
     bool inputChar(char c); //在输入时是否直接一比一输出
     void toggleMode(); //按capslock来切换模式@call
-    std::vector<std::u32string> getCandidates() const; //获取当前候选栏内容
-    std::u32string chooseCandidate(size_t index); //选择候选的某个
+    std::vector<std::u32string> getCandidates() const; //获取当前候选栏内容（前 kMaxCandidates 个）
+    std::vector<std::u32string> candidates(size_t k, size_t offset = 0) const; //按排名取第 offset 起的 k 个候选，只搜到需要的位置
+    std::u32string chooseCandidate(size_t index, bool remember = true); //选择候选的某个；remember 为 false 时不记进选词记录
+    void acceptCandidate(std::u32string_view cand, bool remember = true); //提交上层已经算好的候选（candidates 的结果），不再搜索
     std::string getBuffer() const { return buffer_; } //debug用的，返回buffer值
-    void clearBuffer() { buffer_.clear(); committed_.clear(); committed_length_ = 0; } //然后清空buffer
-    void deleteLastChar() { 
-        if (!buffer_.empty() && buffer_.size() > committed_length_) 
-            buffer_.pop_back(); 
-    } //删除最后一个字符
+    void clearBuffer(); //然后清空buffer
+    void deleteLastChar(); //删除最后一个字符
     Mode getMode() const { return mode_; } //debug用的，返回mode值
+    uint64_t version() const { return version_; } //状态版本：buffer 或 mode 每变一次加一，供上层缓存候选
+    std::string_view activeBuffer() const; //还没提交的那段输入码
+    const std::u32string& committed() const { return committed_; } //已提交部分，候选都以它开头
 
+    // 同 candidates，但用调用方自己的 Converter 算（CandidateWorker 用）
+    static std::vector<std::u32string> candidatesFor(Converter& conv, std::string_view active,
+        const std::u32string& committed, size_t k, size_t offset = 0);
+
+    static constexpr size_t kMaxCandidates = 60; // 候选栏最多保留的候选数
 
 private:
-    Dictionary* dict_;
+    const Dictionary* dict_;
+    UserHistory* history_ = nullptr;
     std::string buffer_;
     Mode mode_;
     std::u32string committed_;  // Already confirmed part before current buffer
     size_t committed_length_;   // Length of committed part in buffer_
-    
-    std::vector<std::u32string> getCandidatesImpl() const;  // Internal implementation
+    uint64_t version_ = 0;
+
+    mutable Converter conv_;  // active buffer 的词格，只是由 buffer_ 与字典推导出的缓存
+
+    void syncConverter() const;  // 让 conv_ 与 active buffer 保持一致
+    std::vector<std::u32string> getCandidatesImpl(size_t k, size_t offset = 0) const;  // Internal implementation
 };
 // 执行层
-inline Engine::Engine(Dictionary* dict)
-    : dict_(dict), mode_(Mode::IPA), committed_length_(0)
+inline Engine::Engine(const Dictionary* dict)
+    : dict_(dict), mode_(Mode::IPA), committed_length_(0), conv_(dict)
+{
+}
+
+inline void Engine::setDictionary(const Dictionary* dict)
+{
+    if (dict == dict_)
+        return;
+    dict_ = dict;
+    conv_.setDictionary(dict);
+    ++version_;  // 候选变了
+}
+
+inline void Engine::setHistory(UserHistory* history)
+{
+    history_ = history;
+    conv_.setHistory(history);
+    ++version_;  // 候选顺序可能变了
+}
+
+inline void Engine::setBeamWidth(size_t width)
+{
+    if (width == conv_.beamWidth())
+        return;
+    conv_.setBeamWidth(width);
+    ++version_;  // 候选变了
+}
+
+inline void Engine::clearBuffer()
+{
+    buffer_.clear();
+    committed_.clear();
+    committed_length_ = 0;
+    ++version_;
+    conv_.clear();
+}
+
+inline void Engine::deleteLastChar()
 {
+    if (!buffer_.empty() && buffer_.size() > committed_length_) {
+        buffer_.pop_back();
+        ++version_;
+        syncConverter();
+    }
 }
 
 inline void Engine::toggleMode() {
@@ -55,20 +105,20 @@ inline void Engine::toggleMode() {
         mode_ = Mode::ENG;
     else
         mode_ = Mode::IPA;
-    buffer_.clear();
-    committed_.clear();
-    committed_length_ = 0;
+    clearBuffer();
 }
 
 inline bool Engine::inputChar(char c)
 {
+    SCRIPA_TRACE_SCOPE(InputChar);
+    ++version_;
     if (mode_ == Mode::ENG) {
         buffer_.push_back(c);
         return true; // 那还说什么了，直接给了
     }
     if (c == ' ') {
         // 空格键：提交第一个候选
-        auto candidates = getCandidatesImpl();  // Get pure candidates without committed_
+        auto candidates = getCandidatesImpl(1);  // Get pure candidates without committed_
         if (!candidates.empty()) {
             committed_ += candidates[0];  // Add first candidate to committed
             committed_ += U' ';  // Add space
@@ -77,14 +127,21 @@ inline bool Engine::inputChar(char c)
         }
         buffer_.push_back(' ');  // Keep space in buffer for display
         committed_length_ = buffer_.size();  // Mark everything before this as committed
+        syncConverter();
         return true;
     }
     buffer_.push_back(c);
+    syncConverter();
     // 返回是否有候选（总是返回 true 让 UI 刷新）
     return true;
 }
 
 inline std::vector<std::u32string> Engine::getCandidates() const
+{
+    return candidates(kMaxCandidates);
+}
+
+inline std::vector<std::u32string> Engine::candidates(size_t k, size_t offset) const
 {
     if (mode_ == Mode::ENG)
         return {};
@@ -92,87 +149,42 @@ inline std::vector<std::u32string> Engine::getCandidates() const
     if (!dict_)
         return {};
 
-    // Get uncommitted part of buffer
-    std::string active_buffer = (committed_length_ < buffer_.size()) 
-                                 ? buffer_.substr(committed_length_) 
-                                 : "";
+    return candidatesFor(conv_, activeBuffer(), committed_, k, offset);
+}
 
+inline std::vector<std::u32string> Engine::candidatesFor(Converter& conv, std::string_view active,
+    const std::u32string& committed, size_t k, size_t offset)
+{
     // If active buffer is empty, return committed as the only candidate
-    if (active_buffer.empty()) {
-        if (committed_.empty()) {
+    if (active.empty()) {
+        if (committed.empty() || offset > 0 || k == 0) {
             return {};
         }
-        return {committed_};
+        return {committed};
     }
 
-    // Performance optimization for long input
-    // Trigger at 11, 19, 27, ... (8n+3 chars)
-    if (active_buffer.size() >= 11) {
-        // Calculate prefix size: largest multiple of 8 that's <= buffer_size - 3
-        size_t prefix_size = ((active_buffer.size() - 3) / 8) * 8;
-        
-        // Create a temporary engine with first prefix_size chars
-        std::string prefix = active_buffer.substr(0, prefix_size);
-        Engine temp_engine(dict_);
-        temp_engine.buffer_ = prefix;
-        temp_engine.mode_ = Mode::IPA;
-        
-        auto prefix_candidates = temp_engine.getCandidatesImpl();
-        if (prefix_candidates.empty()) {
-            // Fallback to full search if prefix fails
-            auto full_candidates = getCandidatesImpl();
-            std::vector<std::u32string> result;
-            for (const auto& cand : full_candidates) {
-                result.push_back(committed_ + cand);
-            }
-            return result;
-        }
-        
-        // Get the best candidate's segmentation info
-        // Try to find optimal break point by checking if chars at prefix_size+1/+2/+3 could be part of same segment
-        // Continue extending as long as the segment is in dictionary
-        
-        size_t break_point = prefix_size;
-        for (size_t extend = prefix_size + 1; extend <= std::min(active_buffer.size(), prefix_size + 3); ++extend) {
-            std::string test_seg = active_buffer.substr(prefix_size - 1, extend - prefix_size + 1);
-            auto lookup = dict_->Lookup(test_seg);
-            if (!lookup.empty()) {
-                break_point = extend;  // Update to this valid segment, continue to check longer
-            } else {
-                break;  // Not in dictionary, stop extending
-            }
-        }
-        
-        // Recursively process the remaining part
-        if (break_point < active_buffer.size()) {
-            std::string suffix = active_buffer.substr(break_point);
-            Engine temp_suffix(dict_);
-            temp_suffix.buffer_ = suffix;
-            temp_suffix.mode_ = Mode::IPA;
-            auto suffix_candidates = temp_suffix.getCandidates();
-            
-            // Combine prefix best candidate with suffix candidates
-            std::vector<std::u32string> result;
-            for (const auto& suffix_cand : suffix_candidates) {
-                result.push_back(committed_ + prefix_candidates[0] + suffix_cand);
-            }
-            if (result.size() > 60) result.resize(60);
-            return result;
-        }
-        
-        // If no suffix, just return prefix candidates with committed prefix
-        std::vector<std::u32string> result;
-        for (const auto& cand : prefix_candidates) {
-            result.push_back(committed_ + cand);
-        }
-        return result;
+    conv.assign(active);
+    auto result = conv.candidates(k, offset);
+    if (!committed.empty()) {
+        for (auto& cand : result) cand = committed + cand;
     }
+    return result;
+}
 
-    return getCandidatesImpl();
+inline std::string_view Engine::activeBuffer() const
+{
+    return std::string_view(buffer_).substr(std::min(committed_length_, buffer_.size()));
 }
 
-// The actual implementation (extracted from original getCandidates)
-inline std::vector<std::u32string> Engine::getCandidatesImpl() const
+// 输入码只在末尾增删，每次只给 conv_ 追加或弹出一列
+inline void Engine::syncConverter() const
+{
+    if (!dict_ || mode_ == Mode::ENG)
+        return;
+    conv_.assign(activeBuffer());
+}
+
+inline std::vector<std::u32string> Engine::getCandidatesImpl(size_t k, size_t offset) const
 {
     if (mode_ == Mode::ENG)
         return {};
@@ -180,201 +192,28 @@ inline std::vector<std::u32string> Engine::getCandidatesImpl() const
     if (!dict_)
         return {};
 
-    // Get uncommitted part of buffer
-    std::string active_buffer = (committed_length_ < buffer_.size()) 
-                                 ? buffer_.substr(committed_length_) 
-                                 : "";
-
-    // Helper: get digit count in T-pattern (e.g., T132 -> 3, T1 -> 1, not T-pattern -> 0)
-    auto getT_digitCount = [](const std::string &buf) -> int {
-        if (buf.empty() || buf[0] != 'T') return 0;
-        size_t i = 1;
-        int count = 0;
-        while (i < buf.size() && buf[i] >= '1' && buf[i] <= '5') {
-            count++;
-            i++;
-        }
-        if (count == 0) return 0;  // no digits after T
-        if (i == buf.size() || buf[i] == 'T') return count;  // valid T-pattern
-        return 0;  // invalid
-    };
-
-    // Count T-patterns in buffer
-    auto countT_patternsInBuffer = [&]() -> int {
-        int count = 0;
-        size_t i = 0;
-        while (i < active_buffer.size()) {
-            if (active_buffer[i] == 'T' && i + 1 < active_buffer.size() && active_buffer[i+1] >= '1' && active_buffer[i+1] <= '5') {
-                count++;
-                i++;
-                while (i < active_buffer.size() && active_buffer[i] >= '1' && active_buffer[i] <= '5') i++;
-                if (i < active_buffer.size() && active_buffer[i] == 'T') i++;
-            } else {
-                i++;
-            }
-        }
-        return count;
-    };
-
-    int totalT_patterns = countT_patternsInBuffer();
-
-    // Collect: (result_u32, num_T_converted, max_T_digits, num_segments, num_total_converted, was_in_dict)
-    // where num_T_converted = count of converted T-pattern segments
-    // max_T_digits = maximum digit count in any T-pattern (e.g., T132 -> 3, T12 -> 2)
-    // num_segments = count of segmentation pieces (fewer = more complete match)
-    // num_total_converted = total transformation count across all segments
-    std::vector<std::tuple<std::u32string, int, int, int, int, bool>> collected;
-
-    // exact match
-    {
-        auto exact = dict_->Lookup(active_buffer);
-        if (exact.empty() && !active_buffer.empty()) {
-            exact.push_back(utf8_to_utf32(active_buffer));
-        }
-        
-        for (const auto &e : exact) {
-            bool was_in_dict = (utf32_to_utf8(e) != active_buffer);
-            int t_converted = (was_in_dict && getT_digitCount(active_buffer) > 0) ? 1 : 0;
-            int t_digits = getT_digitCount(active_buffer);
-            int num_segments = 1;  // exact match = 1 segment
-            int total_converted = was_in_dict ? 1 : 0;
-            collected.emplace_back(e, t_converted, t_digits, num_segments, total_converted, was_in_dict);
-        }
-    }
-
-    // segmentation
-    size_t n = active_buffer.size();
-    if (n >= 2) {
-        std::vector<std::string> parts;
-        std::function<void(size_t)> dfs = [&](size_t pos) {
-            if (pos == n) {
-                // Accumulate all candidates from this segmentation
-                int num_parts = static_cast<int>(parts.size());
-                std::vector<std::tuple<std::u32string, int, int, int, int, bool>> accum;
-                accum.push_back({U"", 0, 0, 0, 0, false});
-                
-                for (const auto& p : parts) {
-                    auto v = dict_->Lookup(p);
-                    if (v.empty() && !p.empty()) {
-                        v.push_back(utf8_to_utf32(p));
-                    }
-                    if (v.empty()) return;
-                    
-                    std::vector<std::tuple<std::u32string, int, int, int, int, bool>> next;
-                    for (const auto& a : accum) {
-                        for (const auto& vv : v) {
-                            std::string vv_utf8 = utf32_to_utf8(vv);
-                            bool was_in_dict = (vv_utf8 != p);
-                            
-                            // Track T-pattern conversions
-                            int p_t_digits = getT_digitCount(p);
-                            int new_t_converted = std::get<1>(a) + (was_in_dict && p_t_digits > 0 ? 1 : 0);
-                            int new_max_t_digits = (std::get<2>(a) > p_t_digits) ? std::get<2>(a) : p_t_digits;
-                            int new_segments = std::get<3>(a) + 1;  // increment segment count
-                            int new_total_converted = std::get<4>(a) + (was_in_dict ? 1 : 0);
-                            bool new_in_dict = std::get<5>(a) || was_in_dict;
-                            next.emplace_back(
-                                std::get<0>(a) + vv,
-                                new_t_converted,
-                                new_max_t_digits,
-                                new_segments,
-                                new_total_converted,
-                                new_in_dict
-                            );
-                        }
-                    }
-                    accum.swap(next);
-                }
-                
-                for (const auto &x : accum) collected.push_back(x);
-                return;
-            }
-            for (size_t len = 1; pos + len <= n; ++len) {
-                parts.push_back(active_buffer.substr(pos, len));
-                dfs(pos + len);
-                parts.pop_back();
-            }
-        };
-        dfs(0);
-    }
-
-    // Consolidate by UTF-8 string, keeping best
-    std::unordered_map<std::string, std::tuple<std::u32string, int, int, int, int, bool>> best;
-    for (auto &item : collected) {
-        std::string key = utf32_to_utf8(std::get<0>(item));
-        auto it = best.find(key);
-        if (it == best.end()) {
-            best[key] = item;
-        } else {
-            int old_t = std::get<1>(it->second);
-            int new_t = std::get<1>(item);
-            int old_t_digits = std::get<2>(it->second);
-            int new_t_digits = std::get<2>(item);
-            int old_segments = std::get<3>(it->second);
-            int new_segments = std::get<3>(item);
-            int old_total = std::get<4>(it->second);
-            int new_total = std::get<4>(item);
-            
-            // Keep if: more T, or same T but more T digits, or same T/digits but more total, or same T/digits/total but fewer segments
-            if (new_t > old_t || 
-                (new_t == old_t && new_t_digits > old_t_digits) ||
-                (new_t == old_t && new_t_digits == old_t_digits && new_total > old_total) ||
-                (new_t == old_t && new_t_digits == old_t_digits && new_total == old_total && new_segments < old_segments)) {
-                best[key] = item;
-            }
-        }
-    }
-
-    // Sort: by T-patterns > T-digits > total conversions > segments (fewer=better) > lexicographic
-    std::vector<std::tuple<std::u32string, int, int, int, int, bool>> out;
-    out.reserve(best.size());
-    for (auto &kv : best) out.push_back(kv.second);
-    
-    std::sort(out.begin(), out.end(), [](const auto &a, const auto &b){
-        // 1. T-pattern conversions
-        int a_t = std::get<1>(a);
-        int b_t = std::get<1>(b);
-        if (a_t != b_t) return a_t > b_t;
-        
-        // 2. T-pattern digit length
-        int a_t_digits = std::get<2>(a);
-        int b_t_digits = std::get<2>(b);
-        if (a_t_digits != b_t_digits) return a_t_digits > b_t_digits;
-        
-        // 3. Total conversions (more = better quality)
-        int a_total = std::get<4>(a);
-        int b_total = std::get<4>(b);
-        if (a_total != b_total) return a_total > b_total;
-        
-        // 4. Segment count (fewer = more complete match)
-        int a_segments = std::get<3>(a);
-        int b_segments = std::get<3>(b);
-        if (a_segments != b_segments) return a_segments < b_segments;
-        
-        // 5. Lexicographic
-        return utf32_to_utf8(std::get<0>(a)) < utf32_to_utf8(std::get<0>(b));
-    });
-
-    // build result vector (pure result without committed_)
-    std::vector<std::u32string> result;
-    result.reserve(out.size());
-    for (auto &p : out) result.push_back(std::get<0>(p));
-    if (result.size() > 60) result.resize(60);
-    return result;
+    syncConverter();
+    return conv_.candidates(k, offset);
 }
 
-inline std::u32string  Engine::chooseCandidate(size_t index)
+inline std::u32string  Engine::chooseCandidate(size_t index, bool remember)
 {
     if (!dict_)
         return U"";
 
-    auto cand = getCandidates();
-    if (index >= cand.size())
+    auto cand = candidates(1, index);
+    if (cand.empty())
         return U"";
 
-    std::u32string result = cand[index];
-    buffer_.clear();
-    committed_.clear();  // Clear committed part after choosing
-    committed_length_ = 0;  // Reset committed length
-    return result;
+    acceptCandidate(cand[0], remember);
+    return cand[0];
+}
+
+inline void Engine::acceptCandidate(std::u32string_view cand, bool remember)
+{
+    // 只记还没提交的那段：committed_ 是空格提交的首选，不算用户挑的
+    std::string_view active = activeBuffer();
+    if (remember && history_ && !active.empty() && cand.size() > committed_.size())
+        history_->record(active, cand.substr(committed_.size()));
+    clearBuffer();  // Clear committed part after choosing
 }
\ No newline at end of file
@@ -5,42 +5,73 @@
 #include <unordered_set>
 #include <filesystem>
 #include <iostream>
+#include <memory>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
 
 #include "Dic.hpp"
+#include "BuiltinSchemes.hpp"
 
 class SchemeLoader {
 public:
     SchemeLoader();
     
-    // 加载所有启用的 scheme 文件
+    // 让 dict 的字库层与目录里已启用的 scheme 一致：新启用或源文件变了的加一层，禁用或已删除的移除一层，
+    // 其余层原样保留，不重新加载。返回 dict 里来自该目录的层数
     int loadSchemes(const std::string& dirPath, Dictionary& dict);
     
-    // 字库启用/禁用管理
+    // 字库启用/禁用管理（下一次 loadSchemes 时生效）。启用的顺序就是默认的优先顺序：
+    // 先启用的排在前面（配置文件里 enabledSchemes 按列出的顺序启用）
     void enableScheme(const std::string& schemeName);
     void disableScheme(const std::string& schemeName);
     bool isSchemeEnabled(const std::string& schemeName) const;
+
+    // 字库层的优先级：大者的候选排在前面。显式设置的优先；否则按启用顺序依次为 0, -1, -2, ...
+    // 默认 custom 为 kCustomPriority，总是最高
+    void setSchemePriority(const std::string& schemeName, int priority);
+    int schemePriority(const std::string& schemeName) const;
+    static constexpr int kCustomPriority = 100;
     
-    // 获取所有可用字库名称（从文件系统扫描）
+    // 获取所有可用字库名称（从文件系统扫描，按名称排序）
     std::vector<std::string> getAvailableSchemes(const std::string& dirPath) const;
     
-    // 获取所有已启用的字库名称
+    // 获取所有已启用的字库名称，按启用顺序
     std::vector<std::string> getEnabledSchemes() const;
+
+    // 目录下所有 scheme 编译成的二进制镜像：最新则直接映射，任一 .txt 有变动则重新编译
+    std::shared_ptr<const SchemeImage> loadCompiledSchemes(const std::string& dirPath) const;
+
+    // 编进程序的字库表（默认 kBuiltinSchemes）：目录里同名的 .txt 与生成表时一样时，这一层直接查表，
+    // 不再从镜像合并。传 nullptr 则全部照旧从镜像加载
+    void setBuiltinSchemes(const StaticSchemes* schemes) { builtin_ = schemes; }
+    const StaticSchemes* builtinSchemes() const { return builtin_; }
+
+    // 不读任何文件：把已启用、表里也有的字库按各自的优先级作为编进程序的层放进 dict（算作从 dirPath 加载），
+    // 启动时先用它，再用 loadSchemes 补上其余的字库、并核对这些文件确实没改过。返回放进去的层数
+    int attachBuiltinSchemes(Dictionary& dict, const std::string& dirPath) const;
+
+    static constexpr const char* kCompiledFileName = "schemes.bin";
     
 private:
     bool isSchemeFile(const std::filesystem::path& p) const;
     std::string getSchemeNameFromPath(const std::filesystem::path& p) const;
+    std::vector<std::filesystem::path> listSchemeFiles(const std::string& dirPath) const;
+    int matchBuiltin(const std::filesystem::path& path, const std::string& schemeName) const; // 文件与表里的一节相同时返回节号，否则 -1
     
-    std::unordered_set<std::string> enabled_schemes_;  // 存储已启用的字库名（不含扩展名）
+    std::vector<std::string> enabled_schemes_;         // 已启用的字库名（不含扩展名），按启用顺序
+    std::unordered_map<std::string, int> priorities_;  // 显式设置的优先级
+    const StaticSchemes* builtin_ = &kBuiltinSchemes;
 };
 // 执行层
 inline SchemeLoader::SchemeLoader() {
     // 默认全部启用（通过空集合表示"全部启用"，或显式添加）
     // 我们采用显式方式：默认添加所有已知字库
-    enabled_schemes_.insert("custom");
-    enabled_schemes_.insert("simple");
-    enabled_schemes_.insert("default");
-    enabled_schemes_.insert("tones");
+    enabled_schemes_ = {"custom", "simple", "default", "tones"};
     // 用户可以通过扫描目录动态添加
+
+    // 用户自己的 custom 总是压过自带的字库
+    priorities_["custom"] = kCustomPriority;
 }
 
 inline bool SchemeLoader::isSchemeFile(const std::filesystem::path& p) const
@@ -54,15 +85,30 @@ inline std::string SchemeLoader::getSchemeNameFromPath(const std::filesystem::pa
 }
 
 inline void SchemeLoader::enableScheme(const std::string& schemeName) {
-    enabled_schemes_.insert(schemeName);
+    if (!isSchemeEnabled(schemeName))
+        enabled_schemes_.push_back(schemeName);  // 已启用的保持原来的位置
 }
 
 inline void SchemeLoader::disableScheme(const std::string& schemeName) {
-    enabled_schemes_.erase(schemeName);
+    enabled_schemes_.erase(std::remove(enabled_schemes_.begin(), enabled_schemes_.end(), schemeName),
+                           enabled_schemes_.end());
 }
 
 inline bool SchemeLoader::isSchemeEnabled(const std::string& schemeName) const {
-    return enabled_schemes_.find(schemeName) != enabled_schemes_.end();
+    return std::find(enabled_schemes_.begin(), enabled_schemes_.end(), schemeName) != enabled_schemes_.end();
+}
+
+inline void SchemeLoader::setSchemePriority(const std::string& schemeName, int priority) {
+    priorities_[schemeName] = priority;
+}
+
+inline int SchemeLoader::schemePriority(const std::string& schemeName) const {
+    auto it = priorities_.find(schemeName);
+    if (it != priorities_.end())
+        return it->second;
+    // 没启用的排在所有已启用的之后
+    auto pos = std::find(enabled_schemes_.begin(), enabled_schemes_.end(), schemeName);
+    return -static_cast<int>(pos - enabled_schemes_.begin());
 }
 
 inline std::vector<std::string> SchemeLoader::getAvailableSchemes(const std::string& dirPath) const {
@@ -79,16 +125,109 @@ inline std::vector<std::string> SchemeLoader::getAvailableSchemes(const std::str
     } catch (std::exception& e) {
         std::cerr << "SchemeLoader::getAvailableSchemes error: " << e.what() << "\n";
     }
-    
+    std::sort(schemes.begin(), schemes.end());  // directory_iterator 的顺序因平台和文件系统而异
     return schemes;
 }
 
 inline std::vector<std::string> SchemeLoader::getEnabledSchemes() const {
-    std::vector<std::string> result;
+    return enabled_schemes_;
+}
+
+inline std::vector<std::filesystem::path> SchemeLoader::listSchemeFiles(const std::string& dirPath) const
+{
+    namespace fs = std::filesystem;
+    std::vector<fs::path> files;
+    for (const auto& entry : fs::directory_iterator(dirPath)) {
+        if (!entry.is_regular_file()) continue;
+        if (!isSchemeFile(entry.path())) continue;
+        files.push_back(entry.path());
+    }
+    std::sort(files.begin(), files.end());  // 编译镜像与同优先级层的顺序都不随文件系统变化
+    return files;
+}
+
+inline std::shared_ptr<const SchemeImage> SchemeLoader::loadCompiledSchemes(const std::string& dirPath) const
+{
+    namespace fs = std::filesystem;
+    struct Source {
+        fs::path path;
+        std::string name;
+        uint64_t mtime;
+        uint64_t size;
+    };
+    std::vector<Source> sources;
+    for (const auto& path : listSchemeFiles(dirPath)) {
+        std::error_code ec;
+        auto mtime = fs::last_write_time(path, ec).time_since_epoch().count();
+        auto size = fs::file_size(path, ec);
+        sources.push_back({path, getSchemeNameFromPath(path), static_cast<uint64_t>(mtime), static_cast<uint64_t>(size)});
+    }
+
+    std::string imagePath = (fs::path(dirPath) / kCompiledFileName).string();
+
+    // 镜像里记录的每个源文件都没变、也没有增删，才算最新
+    if (auto image = SchemeImage::mapFile(imagePath)) {
+        bool fresh = image->schemeCount() == sources.size();
+        for (size_t i = 0; fresh && i < sources.size(); ++i) {
+            int idx = image->findScheme(sources[i].name);
+            fresh = idx >= 0
+                && image->scheme(idx).source_mtime == sources[i].mtime
+                && image->scheme(idx).source_size == sources[i].size;
+        }
+        if (fresh)
+            return image;
+    }
+
+    std::cout << "[SchemeLoader] Compiling schemes into: " << imagePath << "\n";
+    SchemeImageBuilder builder;
+    for (const auto& src : sources) {
+        builder.beginScheme(src.name, src.mtime, src.size);
+        Dictionary::parseSchemeText(src.path.string(), builder);
+    }
+    std::vector<char> bytes = builder.finish();
+
+    if (writeSchemeImage(imagePath, bytes)) {
+        if (auto image = SchemeImage::mapFile(imagePath))
+            return image;
+    }
+    // 目录不可写（例如安装在只读位置）时就用内存里的镜像
+    std::cerr << "[SchemeLoader] Cannot write " << imagePath << ", using in-memory image\n";
+    return SchemeImage::fromBytes(std::move(bytes));
+}
+
+inline int SchemeLoader::matchBuiltin(const std::filesystem::path& path, const std::string& schemeName) const
+{
+    int idx = builtin_ ? builtin_->findScheme(schemeName) : -1;
+    if (idx < 0)
+        return -1;
+    const StaticSchemes::Scheme& expected = builtin_->schemes[idx];
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open())
+        return -1;
+    std::stringstream ss;
+    ss << in.rdbuf();
+    const std::string bytes = ss.str();
+    // 只比内容（不解析）：换行风格不同不算改过，所以不比大小，只比去掉 '\r' 后的指纹
+    return StaticSchemes::fingerprint(bytes) == expected.source_hash ? idx : -1;
+}
+
+inline int SchemeLoader::attachBuiltinSchemes(Dictionary& dict, const std::string& dirPath) const
+{
+    if (!builtin_)
+        return 0;
+    std::vector<Dictionary::Layer> layers;
+    for (const auto& layer : dict.layers()) {
+        if (layer.origin != dirPath) layers.push_back(layer);
+    }
+    int count = 0;
     for (const auto& name : enabled_schemes_) {
-        result.push_back(name);
+        int idx = builtin_->findScheme(name);
+        if (idx < 0) continue;
+        layers.push_back({name, schemePriority(name), nullptr, static_cast<size_t>(idx), dirPath, builtin_});
+        count++;
     }
-    return result;
+    dict.setLayers(std::move(layers));
+    return count;
 }
 
 inline int SchemeLoader::loadSchemes(const std::string& dirPath, Dictionary& dict)
@@ -96,26 +235,79 @@ inline int SchemeLoader::loadSchemes(const std::string& dirPath, Dictionary& dic
     namespace fs = std::filesystem;
     int count = 0;
     try {
-        for (const auto& entry : fs::directory_iterator(dirPath)) {
-            if (!entry.is_regular_file()) continue;
-            auto path = entry.path();
-            if (!isSchemeFile(path)) continue;
-            
+        auto image = loadCompiledSchemes(dirPath);
+
+        // 先算出目标查找链，有变化时一次换上，只建一次合并索引
+        auto loaded = [&](const std::string& name) {
+            auto it = std::find_if(dict.layers().begin(), dict.layers().end(),
+                                   [&](const Dictionary::Layer& l) { return l.origin == dirPath && l.name == name; });
+            return it == dict.layers().end() ? nullptr : &*it;
+        };
+        std::vector<Dictionary::Layer> layers;
+        for (const auto& layer : dict.layers()) {
+            if (layer.origin != dirPath) layers.push_back(layer);  // 别处加载的层不动
+        }
+        bool changed = false;
+        std::unordered_set<std::string> present;
+
+        for (const auto& path : listSchemeFiles(dirPath)) {
             std::string schemeName = getSchemeNameFromPath(path);
+            present.insert(schemeName);
+            const Dictionary::Layer* current = loaded(schemeName);
             
             // 只加载已启用的字库
             if (!isSchemeEnabled(schemeName)) {
-                std::cout << "[SchemeLoader] Skipping (disabled): "
+                std::cout << "[SchemeLoader] " << (current ? "Unloading" : "Skipping") << " (disabled): "
                           << path.string() << "\n";
+                changed |= current != nullptr;
                 continue;
             }
             
+            // 与编进程序的表一样的自带字库直接查表
+            const int priority = schemePriority(schemeName);
+            const int builtin = matchBuiltin(path, schemeName);
+            if (builtin >= 0) {
+                if (!(current && current->builtin == builtin_ && current->scheme == static_cast<size_t>(builtin)
+                      && current->priority == priority)) {
+                    std::cout << "[SchemeLoader] Loading (built-in): " << path.string() << "\n";
+                    changed = true;
+                }
+                layers.push_back({schemeName, priority, nullptr, static_cast<size_t>(builtin), dirPath, builtin_});
+                count++;
+                continue;
+            }
+
+            int idx = image ? image->findScheme(schemeName) : -1;
+            if (idx < 0) {
+                changed |= current != nullptr;
+                continue;
+            }
+
+            // 已经有这一层、源文件与优先级都没变：原样保留
+            if (current && !current->builtin && current->priority == priority
+                && current->image->scheme(current->scheme).source_mtime == image->scheme(idx).source_mtime
+                && current->image->scheme(current->scheme).source_size == image->scheme(idx).source_size) {
+                layers.push_back(*current);
+                count++;
+                continue;
+            }
+
             std::cout << "[SchemeLoader] Loading: "
                       << path.string() << "\n";
-            if (dict.load(path.string())) {
-                count++;
+            layers.push_back({schemeName, priority, image, static_cast<size_t>(idx), dirPath});
+            changed = true;
+            count++;
+        }
+
+        // 源文件已经删掉的字库
+        for (const auto& layer : dict.layers()) {
+            if (layer.origin == dirPath && !present.count(layer.name)) {
+                std::cout << "[SchemeLoader] Unloading (removed): " << layer.name << "\n";
+                changed = true;
             }
         }
+        if (changed)
+            dict.setLayers(std::move(layers));
     } 
     catch (std::exception& e) {
         std::cerr << "SchemeLoader error: " << e.what() << "\n";
@@ -0,0 +1,385 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#ifdef _WIN32
+// 只要文件映射的 API；不让 windows.h 定义 min/max 宏、拉进整套 Win32 头
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// 编译后的 scheme 二进制镜像：所有 schemes/*.txt 合成一个文件，每个 scheme 一节。
+// 布局（本机字节序，各表 8 字节对齐）：
+//   Header
+//   SchemeRecord[scheme_count]  名字、源文件 mtime/size、该节的键区间
+//   KeyRecord[key_count]        每节内按字节序排好的键，指向值区间
+//   ValueRecord[value_count]    值在 UTF-32 池中的位置
+//   char32_t value_pool[]
+//   char string_pool[]          键与 scheme 名
+// 加载时只做边界校验，之后直接在映射的内存上查表，不再解析文本。
+class SchemeImage {
+public:
+    static constexpr uint32_t kVersion = 1;
+    static constexpr uint32_t kByteOrderMark = 0x01020304;
+
+    struct Header {
+        char magic[8];              // "SCRIPAIM"
+        uint32_t version;
+        uint32_t byte_order;        // 读出来不是 kByteOrderMark 说明换了字节序，需要重新编译
+        uint32_t scheme_count;
+        uint32_t key_count;
+        uint32_t value_count;
+        uint32_t value_pool_size;   // char32_t 个数
+        uint32_t string_pool_size;  // 字节数
+        uint32_t reserved;
+    };
+    struct SchemeRecord {
+        uint32_t name_offset;
+        uint32_t name_length;
+        uint32_t key_begin;
+        uint32_t key_count;
+        uint64_t source_mtime;      // 源 .txt 的修改时间与大小，用来判断镜像是否过期
+        uint64_t source_size;
+    };
+    struct KeyRecord {
+        uint32_t key_offset;
+        uint32_t key_length;
+        uint32_t value_begin;
+        uint32_t value_count;
+    };
+    struct ValueRecord {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    ~SchemeImage();
+    SchemeImage(const SchemeImage&) = delete;
+    SchemeImage& operator=(const SchemeImage&) = delete;
+
+    static std::shared_ptr<const SchemeImage> fromBytes(std::vector<char> bytes); // 内存中的镜像
+    static std::shared_ptr<const SchemeImage> mapFile(const std::string& path);   // 只读映射；文件无效时返回 nullptr
+
+    size_t schemeCount() const { return header_->scheme_count; }
+    const SchemeRecord& scheme(size_t index) const { return schemes_[index]; }
+    std::string_view schemeName(size_t index) const;
+    int findScheme(std::string_view name) const; // 找不到返回 -1
+
+    const KeyRecord* keysBegin(size_t scheme) const { return keys_ + schemes_[scheme].key_begin; }
+    const KeyRecord* keysEnd(size_t scheme) const { return keysBegin(scheme) + schemes_[scheme].key_count; }
+    const KeyRecord* findKey(size_t scheme, std::string_view key) const; // 节内二分查找
+    std::string_view key(const KeyRecord& record) const;
+    std::u32string_view value(uint32_t index) const;
+
+private:
+    SchemeImage() = default;
+    bool attach(const char* data, size_t size); // 校验并定位各表
+
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    std::vector<char> owned_;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = NULL;
+#else
+    bool mapped_ = false;
+#endif
+
+    const Header* header_ = nullptr;
+    const SchemeRecord* schemes_ = nullptr;
+    const KeyRecord* keys_ = nullptr;
+    const ValueRecord* values_ = nullptr;
+    const char32_t* value_pool_ = nullptr;
+    const char* string_pool_ = nullptr;
+};
+
+// 把解析好的 (key, value) 按 scheme 收集起来，生成镜像字节
+class SchemeImageBuilder {
+public:
+    void beginScheme(const std::string& name, uint64_t source_mtime = 0, uint64_t source_size = 0);
+    void add(const std::string& key, const std::u32string& value); // 同一个键的值保持加入顺序
+    std::vector<char> finish() const;
+
+private:
+    struct PendingScheme {
+        std::string name;
+        uint64_t source_mtime;
+        uint64_t source_size;
+        std::vector<std::pair<std::string, std::u32string>> entries;
+    };
+    std::vector<PendingScheme> schemes_;
+};
+
+// 先写临时文件再改名，其他进程不会读到写了一半的镜像
+bool writeSchemeImage(const std::string& path, const std::vector<char>& bytes);
+
+
+// 执行层
+inline SchemeImage::~SchemeImage()
+{
+#ifdef _WIN32
+    if (mapping_) {
+        UnmapViewOfFile(data_);
+        CloseHandle(mapping_);
+    }
+    if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+#else
+    if (mapped_) munmap(const_cast<char*>(data_), size_);
+#endif
+}
+
+inline std::shared_ptr<const SchemeImage> SchemeImage::fromBytes(std::vector<char> bytes)
+{
+    std::shared_ptr<SchemeImage> image(new SchemeImage());
+    image->owned_ = std::move(bytes);
+    if (!image->attach(image->owned_.data(), image->owned_.size()))
+        return nullptr;
+    return image;
+}
+
+inline std::shared_ptr<const SchemeImage> SchemeImage::mapFile(const std::string& path)
+{
+    std::shared_ptr<SchemeImage> image(new SchemeImage());
+#ifdef _WIN32
+    image->file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                               NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (image->file_ == INVALID_HANDLE_VALUE)
+        return nullptr;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(image->file_, &size) || size.QuadPart == 0)
+        return nullptr;
+    image->mapping_ = CreateFileMappingA(image->file_, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!image->mapping_)
+        return nullptr;
+    const void* view = MapViewOfFile(image->mapping_, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(image->mapping_);
+        image->mapping_ = NULL;
+        return nullptr;
+    }
+    image->data_ = static_cast<const char*>(view);
+    image->size_ = static_cast<size_t>(size.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return nullptr;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // 映射建立后文件描述符可以关掉
+    if (view == MAP_FAILED)
+        return nullptr;
+    image->mapped_ = true;
+    image->data_ = static_cast<const char*>(view);
+    image->size_ = static_cast<size_t>(st.st_size);
+#endif
+    if (!image->attach(image->data_, image->size_))
+        return nullptr;
+    return image;
+}
+
+inline bool SchemeImage::attach(const char* data, size_t size)
+{
+    data_ = data;
+    size_ = size;
+    if (size < sizeof(Header))
+        return false;
+
+    header_ = reinterpret_cast<const Header*>(data);
+    if (std::memcmp(header_->magic, "SCRIPAIM", 8) != 0) return false;
+    if (header_->version != kVersion) return false;
+    if (header_->byte_order != kByteOrderMark) return false;
+
+    // 各表依次排列，逐段检查不越界
+    uint64_t offset = sizeof(Header);
+    auto take = [&](uint64_t bytes) -> const char* {
+        if (offset + bytes > size) return nullptr;
+        const char* p = data + offset;
+        offset += (bytes + 7) & ~uint64_t(7);
+        return p;
+    };
+    const char* schemes = take(uint64_t(header_->scheme_count) * sizeof(SchemeRecord));
+    const char* keys = take(uint64_t(header_->key_count) * sizeof(KeyRecord));
+    const char* values = take(uint64_t(header_->value_count) * sizeof(ValueRecord));
+    const char* value_pool = take(uint64_t(header_->value_pool_size) * sizeof(char32_t));
+    const char* string_pool = take(header_->string_pool_size);
+    if (!schemes || !keys || !values || !value_pool || !string_pool)
+        return false;
+
+    schemes_ = reinterpret_cast<const SchemeRecord*>(schemes);
+    keys_ = reinterpret_cast<const KeyRecord*>(keys);
+    values_ = reinterpret_cast<const ValueRecord*>(values);
+    value_pool_ = reinterpret_cast<const char32_t*>(value_pool);
+    string_pool_ = string_pool;
+
+    // 校验一次所有引用，之后的查表就不必再检查
+    auto inStrings = [&](uint32_t off, uint32_t len) { return uint64_t(off) + len <= header_->string_pool_size; };
+    for (uint32_t i = 0; i < header_->scheme_count; ++i) {
+        const auto& s = schemes_[i];
+        if (!inStrings(s.name_offset, s.name_length)) return false;
+        if (uint64_t(s.key_begin) + s.key_count > header_->key_count) return false;
+    }
+    for (uint32_t i = 0; i < header_->key_count; ++i) {
+        const auto& k = keys_[i];
+        if (!inStrings(k.key_offset, k.key_length)) return false;
+        if (uint64_t(k.value_begin) + k.value_count > header_->value_count) return false;
+    }
+    for (uint32_t i = 0; i < header_->value_count; ++i) {
+        const auto& v = values_[i];
+        if (uint64_t(v.offset) + v.length > header_->value_pool_size) return false;
+    }
+    return true;
+}
+
+inline std::string_view SchemeImage::schemeName(size_t index) const
+{
+    const auto& s = schemes_[index];
+    return std::string_view(string_pool_ + s.name_offset, s.name_length);
+}
+
+inline int SchemeImage::findScheme(std::string_view name) const
+{
+    for (size_t i = 0; i < schemeCount(); ++i) {
+        if (schemeName(i) == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+inline const SchemeImage::KeyRecord* SchemeImage::findKey(size_t scheme, std::string_view k) const
+{
+    const KeyRecord* first = keysBegin(scheme);
+    const KeyRecord* last = keysEnd(scheme);
+    const KeyRecord* it = std::lower_bound(first, last, k,
+        [&](const KeyRecord& r, std::string_view v) { return key(r) < v; });
+    if (it == last || key(*it) != k)
+        return nullptr;
+    return it;
+}
+
+inline std::string_view SchemeImage::key(const KeyRecord& record) const
+{
+    return std::string_view(string_pool_ + record.key_offset, record.key_length);
+}
+
+inline std::u32string_view SchemeImage::value(uint32_t index) const
+{
+    const auto& v = values_[index];
+    return std::u32string_view(value_pool_ + v.offset, v.length);
+}
+
+inline void SchemeImageBuilder::beginScheme(const std::string& name, uint64_t source_mtime, uint64_t source_size)
+{
+    schemes_.push_back({name, source_mtime, source_size, {}});
+}
+
+inline void SchemeImageBuilder::add(const std::string& key, const std::u32string& value)
+{
+    if (schemes_.empty()) beginScheme("");
+    schemes_.back().entries.emplace_back(key, value);
+}
+
+inline std::vector<char> SchemeImageBuilder::finish() const
+{
+    std::vector<SchemeImage::SchemeRecord> schemes;
+    std::vector<SchemeImage::KeyRecord> keys;
+    std::vector<SchemeImage::ValueRecord> values;
+    std::u32string value_pool;
+    std::string string_pool;
+
+    for (const auto& pending : schemes_) {
+        SchemeImage::SchemeRecord rec{};
+        rec.name_offset = static_cast<uint32_t>(string_pool.size());
+        rec.name_length = static_cast<uint32_t>(pending.name.size());
+        string_pool += pending.name;
+        rec.key_begin = static_cast<uint32_t>(keys.size());
+        rec.source_mtime = pending.source_mtime;
+        rec.source_size = pending.source_size;
+
+        // 稳定排序：同一个键的多个值保持在文件中的先后顺序
+        std::vector<size_t> order(pending.entries.size());
+        for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return pending.entries[a].first < pending.entries[b].first;
+        });
+
+        for (size_t i = 0; i < order.size();) {
+            const std::string& k = pending.entries[order[i]].first;
+            SchemeImage::KeyRecord key{};
+            key.key_offset = static_cast<uint32_t>(string_pool.size());
+            key.key_length = static_cast<uint32_t>(k.size());
+            string_pool += k;
+            key.value_begin = static_cast<uint32_t>(values.size());
+            for (; i < order.size() && pending.entries[order[i]].first == k; ++i) {
+                const std::u32string& v = pending.entries[order[i]].second;
+                values.push_back({static_cast<uint32_t>(value_pool.size()), static_cast<uint32_t>(v.size())});
+                value_pool += v;
+            }
+            key.value_count = static_cast<uint32_t>(values.size()) - key.value_begin;
+            keys.push_back(key);
+        }
+        rec.key_count = static_cast<uint32_t>(keys.size()) - rec.key_begin;
+        schemes.push_back(rec);
+    }
+
+    SchemeImage::Header header{};
+    std::memcpy(header.magic, "SCRIPAIM", 8);
+    header.version = SchemeImage::kVersion;
+    header.byte_order = SchemeImage::kByteOrderMark;
+    header.scheme_count = static_cast<uint32_t>(schemes.size());
+    header.key_count = static_cast<uint32_t>(keys.size());
+    header.value_count = static_cast<uint32_t>(values.size());
+    header.value_pool_size = static_cast<uint32_t>(value_pool.size());
+    header.string_pool_size = static_cast<uint32_t>(string_pool.size());
+
+    std::vector<char> out;
+    auto append = [&](const void* p, size_t bytes) {
+        const char* c = static_cast<const char*>(p);
+        out.insert(out.end(), c, c + bytes);
+        out.resize((out.size() + 7) & ~size_t(7), 0);  // 下一张表 8 字节对齐
+    };
+    append(&header, sizeof(header));
+    append(schemes.data(), schemes.size() * sizeof(SchemeImage::SchemeRecord));
+    append(keys.data(), keys.size() * sizeof(SchemeImage::KeyRecord));
+    append(values.data(), values.size() * sizeof(SchemeImage::ValueRecord));
+    append(value_pool.data(), value_pool.size() * sizeof(char32_t));
+    append(string_pool.data(), string_pool.size());
+    return out;
+}
+
+inline bool writeSchemeImage(const std::string& path, const std::vector<char>& bytes)
+{
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream fout(tmp, std::ios::binary | std::ios::trunc);
+        if (!fout.is_open())
+            return false;
+        fout.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        if (!fout)
+            return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmp, ec);
+        return false;
+    }
+    return true;
+}
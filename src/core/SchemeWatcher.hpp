@@ -0,0 +1,180 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <filesystem>
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
+#else
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+// 监视字库目录：*.txt 有增删改、安静 kSettleTime 之后在后台线程上调用 onChange
+class SchemeWatcher {
+public:
+    SchemeWatcher(std::string dirPath, std::function<void()> onChange);
+    ~SchemeWatcher(); // 停止并等监视线程退出（正在执行的回调会先跑完）
+    SchemeWatcher(const SchemeWatcher&) = delete;
+    SchemeWatcher& operator=(const SchemeWatcher&) = delete;
+
+    bool watching() const { return thread_.joinable(); } // 目录无法监视时为 false
+
+    static constexpr std::chrono::milliseconds kSettleTime{200}; // 一连串改动（写临时文件再改名）合并成一次
+    static constexpr std::chrono::milliseconds kPollInterval{1000}; // 没有 inotify 时比较修改时间与大小的间隔
+
+private:
+    static bool isSchemeName(std::string_view name);
+    void run();
+
+    std::string dir_;
+    std::function<void()> on_change_;
+    std::atomic<bool> stop_{false};
+#ifdef __linux__
+    int inotify_fd_ = -1;
+    int stop_pipe_[2] = {-1, -1};  // 析构时写一个字节，唤醒 poll
+#else
+    using Stamps = std::map<std::string, std::pair<long long, uintmax_t>>;  // 文件名 -> (修改时间, 大小)
+    Stamps scan() const;
+    Stamps last_;  // 上一次扫描的结果：构造时先扫一次，之后的改动才都看得见
+    std::mutex mutex_;
+    std::condition_variable stop_cv_;
+#endif
+    std::thread thread_;
+};
+// 执行层
+inline bool SchemeWatcher::isSchemeName(std::string_view name)
+{
+    return name.size() > 4 && name.substr(name.size() - 4) == ".txt";
+}
+
+#ifdef __linux__
+
+inline SchemeWatcher::SchemeWatcher(std::string dirPath, std::function<void()> onChange)
+    : dir_(std::move(dirPath)), on_change_(std::move(onChange))
+{
+    inotify_fd_ = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+    if (inotify_fd_ < 0 || pipe2(stop_pipe_, O_CLOEXEC) != 0) {
+        std::cerr << "[SchemeWatcher] Cannot create inotify instance\n";
+        return;
+    }
+    const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE;
+    if (inotify_add_watch(inotify_fd_, dir_.c_str(), mask) < 0) {
+        std::cerr << "[SchemeWatcher] Cannot watch " << dir_ << "\n";
+        return;
+    }
+    thread_ = std::thread([this] { run(); });
+}
+
+inline SchemeWatcher::~SchemeWatcher()
+{
+    stop_.store(true);
+    if (thread_.joinable()) {
+        char byte = 0;
+        (void)!write(stop_pipe_[1], &byte, 1);
+        thread_.join();
+    }
+    for (int fd : {inotify_fd_, stop_pipe_[0], stop_pipe_[1]})
+        if (fd >= 0) close(fd);
+}
+
+inline void SchemeWatcher::run()
+{
+    pollfd fds[2] = {{inotify_fd_, POLLIN, 0}, {stop_pipe_[0], POLLIN, 0}};
+    alignas(inotify_event) char buf[4096];
+    bool dirty = false;  // 有改动，还在等它安静下来
+    while (!stop_.load()) {
+        int ready = poll(fds, 2, dirty ? static_cast<int>(kSettleTime.count()) : -1);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (fds[1].revents)
+            break;
+        if (ready == 0) {
+            dirty = false;
+            on_change_();
+            continue;
+        }
+        for (;;) {
+            ssize_t n = read(inotify_fd_, buf, sizeof(buf));
+            if (n <= 0) break;
+            for (char* p = buf; p < buf + n;) {
+                auto* ev = reinterpret_cast<inotify_event*>(p);
+                // 只看 .txt：schemes.bin 也在这个目录里，重建时会被改写
+                if (ev->len > 0 && isSchemeName(ev->name)) dirty = true;
+                p += sizeof(inotify_event) + ev->len;
+            }
+        }
+    }
+}
+
+#else
+
+inline SchemeWatcher::SchemeWatcher(std::string dirPath, std::function<void()> onChange)
+    : dir_(std::move(dirPath)), on_change_(std::move(onChange))
+{
+    std::error_code ec;
+    if (!std::filesystem::is_directory(dir_, ec)) {
+        std::cerr << "[SchemeWatcher] Cannot watch " << dir_ << "\n";
+        return;
+    }
+    last_ = scan();
+    thread_ = std::thread([this] { run(); });
+}
+
+inline SchemeWatcher::~SchemeWatcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_.store(true);
+    }
+    stop_cv_.notify_all();
+    if (thread_.joinable())
+        thread_.join();
+}
+
+inline SchemeWatcher::Stamps SchemeWatcher::scan() const
+{
+    namespace fs = std::filesystem;
+    Stamps stamps;
+    std::error_code ec;
+    for (fs::directory_iterator it(dir_, ec), end; !ec && it != end; it.increment(ec)) {
+        std::string name = it->path().filename().string();
+        if (!isSchemeName(name)) continue;
+        std::error_code fec;
+        auto mtime = fs::last_write_time(it->path(), fec).time_since_epoch().count();
+        auto size = fs::file_size(it->path(), fec);
+        stamps[name] = {static_cast<long long>(mtime), size};
+    }
+    return stamps;
+}
+
+inline void SchemeWatcher::run()
+{
+    bool dirty = false;  // 上一次扫描发现了改动
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_cv_.wait_for(lock, kPollInterval, [this] { return stop_.load(); })) {
+        lock.unlock();
+        Stamps now = scan();
+        if (now != last_) {
+            last_ = std::move(now);
+            dirty = true;
+        } else if (dirty) {
+            dirty = false;
+            on_change_();
+        }
+        lock.lock();
+    }
+}
+
+#endif
@@ -0,0 +1,63 @@
+#pragma once
+#include <string_view>
+#include <cstddef>
+
+// 五度标调：输入码里的 T 后接一串 1-5 的数字（调值，1 最低、5 最高）直接生成调符，不用在字库里逐条列出，任意长度都可以。
+//   T1 … T5    单个调值：带点的左竖调符 ꜑ ꜐ ꜏ ꜎ ꜍
+//   T11 … T55  两位相同的平调：左竖调符 ꜖ ꜕ ꜔ ꜓ ꜒
+//   其余       逐位换成右竖调符 ˩ ˨ ˧ ˦ ˥ 连写成调型，如 T214 -> ˨˩˦
+// 调号属于 tones 字库：只有它启用并已加载时才生成，否则 T 与数字就是普通的输入码。
+// 全是 constexpr，规则在编译时就由下面的 static_assert 对照过。
+
+inline constexpr std::string_view kToneScheme = "tones";
+
+// 层名是否指 tones 字库：SchemeLoader 以字库名作层名，Dictionary::load 以文件路径作层名
+inline constexpr bool tone_is_scheme(std::string_view layer)
+{
+    const size_t slash = layer.find_last_of("/\\");
+    if (slash != std::string_view::npos) layer.remove_prefix(slash + 1);
+    if (layer.size() > 4 && layer.substr(layer.size() - 4) == ".txt") layer.remove_suffix(4);
+    return layer == kToneScheme;
+}
+
+inline constexpr bool tone_is_digit(char c)
+{
+    return c >= '1' && c <= '5';
+}
+
+// digits 须非空且全是 1-5。写入 out 的码点数不超过 digits.size()，返回写了几个
+inline constexpr size_t tone_letters(std::string_view digits, char32_t* out)
+{
+    const size_t n = digits.size();
+    if (n == 1) {
+        out[0] = static_cast<char32_t>(0xA712 - (digits[0] - '0'));
+        return 1;
+    }
+    if (n == 2 && digits[0] == digits[1]) {
+        out[0] = static_cast<char32_t>(0xA717 - (digits[0] - '0'));
+        return 1;
+    }
+    for (size_t i = 0; i < n; ++i) out[i] = static_cast<char32_t>(0x02EA - (digits[i] - '0'));
+    return n;
+}
+
+// tone_letters(digits) 是否恰好是 expected，供下面的 static_assert 对照
+inline constexpr bool tone_letters_match(std::string_view digits, std::u32string_view expected)
+{
+    char32_t buf[8] = {};
+    const size_t n = tone_letters(digits, buf);
+    if (n != expected.size()) return false;
+    for (size_t i = 0; i < n; ++i) {
+        if (buf[i] != expected[i]) return false;
+    }
+    return true;
+}
+
+static_assert(tone_letters_match("1", U"꜑") && tone_letters_match("5", U"꜍"), "T1 ꜑, T5 ꜍");
+static_assert(tone_letters_match("11", U"꜖") && tone_letters_match("55", U"꜒"), "T11 ꜖, T55 ꜒");
+static_assert(tone_letters_match("51", U"˥˩") && tone_letters_match("214", U"˨˩˦"),
+              "T51 ˥˩, T214 ˨˩˦");
+static_assert(tone_letters_match("1111", U"˩˩˩˩"), "T1111 ˩˩˩˩");
+static_assert(tone_is_scheme("tones") && tone_is_scheme("schemes/tones.txt") && tone_is_scheme("C:\\ipa\\tones.txt"),
+              "tones, .../tones.txt");
+static_assert(!tone_is_scheme("mytones") && !tone_is_scheme("tones/default.txt"), "not tones");
@@ -0,0 +1,239 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+
+// 按键延迟分段计时，每段一个无锁直方图；用 -DSCRIPA_TRACE 编译才计时，否则宏展开为空
+//   g++ -std=c++17 -O2 -DSCRIPA_TRACE -Isrc src/main.cpp
+
+enum class TraceStage {
+    InputChar,  // Engine::inputChar
+    Lattice,    // Converter::assign：切分、建词格
+    Search,     // Converter 取候选：搜索整体（含 Sort、Dedup）
+    Sort,       // 候选排序：精确搜索的堆进出，束搜索的排序；一次搜索里各小段之和
+    Dedup,      // 查重：已展开状态与已产出文本，束搜索的同文本前缀
+    Transcode,  // ScripaTSF：候选转 UTF-16
+    Window,     // 候选窗口取一页并更新
+    Paint,      // 候选窗口绘制
+    Count
+};
+
+class LatencyHistogram {
+public:
+    void record(uint64_t ns);
+    void reset();
+
+    struct Summary {
+        uint64_t count = 0;
+        double mean = 0;  // 以下都是纳秒
+        uint64_t p50 = 0, p95 = 0, p99 = 0, max = 0;
+    };
+    Summary summary() const;  // 分位数取所在档的上界，误差不超过 1/8
+
+private:
+    // 对数-线性分档：8 以下每个值一档，之后每个 2 的幂区间分 8 档
+    static constexpr size_t kBuckets = 8 + 61 * 8;
+    static size_t bucketOf(uint64_t ns);
+    static uint64_t bucketUpper(size_t bucket);
+
+    std::atomic<uint64_t> buckets_[kBuckets] = {};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+};
+
+class Trace {
+public:
+#if defined(SCRIPA_TRACE)
+    static constexpr bool kEnabled = true;
+#else
+    static constexpr bool kEnabled = false;
+#endif
+    static LatencyHistogram& histogram(TraceStage stage);
+    static const char* name(TraceStage stage);
+    static void dump(std::ostream& out);  // 每段一行，没有记录的段不列
+    static void reset();
+};
+
+// 作用域计时：构造时取时间，析构时记进该段的直方图
+class TraceScope {
+public:
+    explicit TraceScope(TraceStage stage) : stage_(stage), start_(std::chrono::steady_clock::now()) {}
+    ~TraceScope();
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    TraceStage stage_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// 分散计时：一次调用里的多个小段（每段一个 Part 作用域）加起来，析构时记一笔；一段都没计过就不记
+class TraceTotal {
+public:
+    explicit TraceTotal(TraceStage stage) : stage_(stage) {}
+    ~TraceTotal();
+    TraceTotal(const TraceTotal&) = delete;
+    TraceTotal& operator=(const TraceTotal&) = delete;
+
+    class Part {
+    public:
+        explicit Part(TraceTotal& total) : total_(total), start_(std::chrono::steady_clock::now()) {}
+        ~Part();
+        Part(const Part&) = delete;
+        Part& operator=(const Part&) = delete;
+
+    private:
+        TraceTotal& total_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+private:
+    TraceStage stage_;
+    std::chrono::steady_clock::duration sum_{};
+    bool used_ = false;
+};
+
+#if defined(SCRIPA_TRACE)
+#define SCRIPA_TRACE_CONCAT_(a, b) a##b
+#define SCRIPA_TRACE_CONCAT(a, b) SCRIPA_TRACE_CONCAT_(a, b)
+#define SCRIPA_TRACE_SCOPE(stage) TraceScope SCRIPA_TRACE_CONCAT(scripa_trace_, __LINE__)(TraceStage::stage)
+#define SCRIPA_TRACE_TOTAL(name, stage) TraceTotal name(TraceStage::stage)
+#define SCRIPA_TRACE_PART(name) TraceTotal::Part SCRIPA_TRACE_CONCAT(scripa_trace_, __LINE__)(name)
+#else
+#define SCRIPA_TRACE_SCOPE(stage) ((void)0)
+#define SCRIPA_TRACE_TOTAL(name, stage) ((void)0)
+#define SCRIPA_TRACE_PART(name) ((void)0)
+#endif
+
+// 执行层
+inline size_t LatencyHistogram::bucketOf(uint64_t ns)
+{
+    if (ns < 8)
+        return static_cast<size_t>(ns);
+#if defined(__GNUC__) || defined(__clang__)
+    const int e = 63 - __builtin_clzll(ns);
+#else
+    int e = 3;
+    while ((ns >> (e + 1)) != 0) ++e;
+#endif
+    return 8 + static_cast<size_t>(e - 3) * 8 + static_cast<size_t>((ns >> (e - 3)) & 7);
+}
+
+inline uint64_t LatencyHistogram::bucketUpper(size_t bucket)
+{
+    if (bucket < 8)
+        return bucket;
+    const int e = static_cast<int>((bucket - 8) / 8) + 3;
+    const uint64_t sub = (bucket - 8) % 8;
+    return ((8 + sub) << (e - 3)) + ((uint64_t(1) << (e - 3)) - 1);
+}
+
+inline void LatencyHistogram::record(uint64_t ns)
+{
+    buckets_[bucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(ns, std::memory_order_relaxed);
+    uint64_t prev = max_.load(std::memory_order_relaxed);
+    while (ns > prev && !max_.compare_exchange_weak(prev, ns, std::memory_order_relaxed)) {}
+}
+
+inline void LatencyHistogram::reset()
+{
+    for (auto& b : buckets_) b.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+// 各档分别读取，与同时进行的 record 之间不是一个快照，只影响刚记的那几次
+inline LatencyHistogram::Summary LatencyHistogram::summary() const
+{
+    uint64_t counts[kBuckets];
+    Summary s;
+    for (size_t b = 0; b < kBuckets; ++b) {
+        counts[b] = buckets_[b].load(std::memory_order_relaxed);
+        s.count += counts[b];
+    }
+    if (s.count == 0)
+        return s;
+    s.max = max_.load(std::memory_order_relaxed);
+    s.mean = static_cast<double>(sum_.load(std::memory_order_relaxed)) / static_cast<double>(s.count);
+
+    auto percentile = [&](double q) {
+        const uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(s.count - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t b = 0; b < kBuckets; ++b) {
+            seen += counts[b];
+            if (seen >= rank) return bucketUpper(b) < s.max ? bucketUpper(b) : s.max;
+        }
+        return s.max;
+    };
+    s.p50 = percentile(0.50);
+    s.p95 = percentile(0.95);
+    s.p99 = percentile(0.99);
+    return s;
+}
+
+inline LatencyHistogram& Trace::histogram(TraceStage stage)
+{
+    static LatencyHistogram histograms[static_cast<size_t>(TraceStage::Count)];
+    return histograms[static_cast<size_t>(stage)];
+}
+
+inline const char* Trace::name(TraceStage stage)
+{
+    static const char* const names[] = {"inputChar", "lattice", "search", "sort", "dedup",
+                                        "transcode", "window", "paint"};
+    static_assert(sizeof(names) / sizeof(names[0]) == static_cast<size_t>(TraceStage::Count), "one name per stage");
+    return names[static_cast<size_t>(stage)];
+}
+
+inline void Trace::dump(std::ostream& out)
+{
+    if (!kEnabled) {
+        out << "[Trace] Built without SCRIPA_TRACE, nothing recorded\n";
+        return;
+    }
+    char line[160];
+    std::snprintf(line, sizeof(line), "%-10s %10s %10s %10s %10s %10s %10s\n",
+                  "stage(us)", "count", "mean", "p50", "p95", "p99", "max");
+    out << line;
+    for (size_t i = 0; i < static_cast<size_t>(TraceStage::Count); ++i) {
+        auto stage = static_cast<TraceStage>(i);
+        LatencyHistogram::Summary s = histogram(stage).summary();
+        if (s.count == 0)
+            continue;
+        std::snprintf(line, sizeof(line), "%-10s %10llu %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+                      name(stage), static_cast<unsigned long long>(s.count), s.mean / 1e3,
+                      s.p50 / 1e3, s.p95 / 1e3, s.p99 / 1e3, s.max / 1e3);
+        out << line;
+    }
+    out.flush();
+}
+
+inline void Trace::reset()
+{
+    for (size_t i = 0; i < static_cast<size_t>(TraceStage::Count); ++i)
+        histogram(static_cast<TraceStage>(i)).reset();
+}
+
+inline TraceScope::~TraceScope()
+{
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count();
+    Trace::histogram(stage_).record(ns > 0 ? static_cast<uint64_t>(ns) : 0);
+}
+
+inline TraceTotal::Part::~Part()
+{
+    total_.sum_ += std::chrono::steady_clock::now() - start_;
+    total_.used_ = true;
+}
+
+inline TraceTotal::~TraceTotal()
+{
+    if (!used_)
+        return;
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(sum_).count();
+    Trace::histogram(stage_).record(ns > 0 ? static_cast<uint64_t>(ns) : 0);
+}
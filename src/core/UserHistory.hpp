@@ -0,0 +1,195 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <fstream>
+#include <iostream>
+#include <filesystem>
+#include <algorithm>
+#include <mutex>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include "Utf.hpp"
+
+// 用户选词记录：只追加的日志，每行 "次数\t输入码\t候选"（UTF-8）；内部加锁，任意线程可用
+class UserHistory {
+public:
+    struct Entry {
+        std::u32string text;
+        uint32_t count = 0;
+        uint64_t last = 0;  // 最近一次选它的序号，大者更近
+    };
+
+    UserHistory() = default;  // 不打开文件时只记在内存里
+    UserHistory(const UserHistory&) = delete;
+    UserHistory& operator=(const UserHistory&) = delete;
+
+    bool open(const std::string& path); // 读入已有日志，之后的记录追加到这里；文件不存在时新建
+    void record(std::string_view code, std::u32string_view text); // 在 code 下选了 text
+    std::vector<Entry> lookup(std::string_view code, size_t k = kMaxLearned) const; // code 下排名前 k 的记录
+    bool compact(); // 把日志重写成每项一行
+    void clear();   // 清空记录（含日志文件）
+
+    uint64_t version() const { return version_.load(std::memory_order_acquire); } // 每记一次加一
+    size_t size() const;
+
+    static constexpr size_t kMaxLearned = 3;  // 每个输入码最多提前几个候选
+
+private:
+    void add(std::string code, std::u32string_view text, uint32_t count);  // 调用方持锁
+    bool rewrite();                                                          // 调用方持锁
+    bool needsCompaction() const { return log_lines_ > 2 * entries_ + 64; }
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::vector<Entry>> table_;  // 输入码 -> 选过的候选
+    size_t entries_ = 0;     // 表里的 (输入码, 候选) 项数
+    size_t log_lines_ = 0;   // 日志里的行数
+    uint64_t seq_ = 0;
+    std::string path_;
+    std::ofstream log_;
+    std::atomic<uint64_t> version_{0};
+};
+// 执行层
+inline void UserHistory::add(std::string code, std::u32string_view text, uint32_t count)
+{
+    auto& list = table_[std::move(code)];
+    auto it = std::find_if(list.begin(), list.end(), [&](const Entry& e) { return e.text == text; });
+    if (it == list.end()) {
+        list.push_back({std::u32string(text), 0, 0});
+        it = list.end() - 1;
+        ++entries_;
+    }
+    it->count += count;
+    it->last = ++seq_;
+}
+
+inline bool UserHistory::open(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    table_.clear();
+    entries_ = log_lines_ = 0;
+    seq_ = 0;
+    log_.close();
+    path_ = path;
+
+    std::ifstream in(path, std::ios::binary);
+    std::string line;
+    while (in && std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        size_t t1 = line.find('\t');
+        size_t t2 = t1 == std::string::npos ? t1 : line.find('\t', t1 + 1);
+        if (t2 == std::string::npos) continue;  // 写到一半的行
+        long count = std::atol(line.substr(0, t1).c_str());
+        if (count <= 0 || t2 == t1 + 1 || t2 + 1 == line.size()) continue;
+        add(line.substr(t1 + 1, t2 - t1 - 1), utf8_to_utf32(line.substr(t2 + 1)),
+            static_cast<uint32_t>(count));
+        ++log_lines_;
+    }
+    in.close();
+
+    if (needsCompaction())
+        rewrite();
+    if (!log_.is_open())
+        log_.open(path, std::ios::binary | std::ios::app);
+    version_.fetch_add(1, std::memory_order_release);
+    if (!log_.is_open()) {
+        std::cerr << "[UserHistory] Cannot write " << path << ", history is kept in memory only\n";
+        return false;
+    }
+    return true;
+}
+
+inline void UserHistory::record(std::string_view code, std::u32string_view text)
+{
+    // 制表符和换行是日志的分隔符，这样的输入不记
+    if (code.empty() || text.empty() || code.find_first_of("\t\r\n") != std::string_view::npos)
+        return;
+    for (char32_t ch : text)
+        if (ch == U'\t' || ch == U'\r' || ch == U'\n') return;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    add(std::string(code), text, 1);
+    if (log_.is_open()) {
+        log_ << "1\t" << code << '\t' << utf32_to_utf8(text) << '\n';
+        log_.flush();
+        ++log_lines_;
+        if (needsCompaction())
+            rewrite();
+    }
+    version_.fetch_add(1, std::memory_order_release);
+}
+
+inline std::vector<UserHistory::Entry> UserHistory::lookup(std::string_view code, size_t k) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = table_.find(std::string(code));
+    if (it == table_.end() || k == 0)
+        return {};
+    std::vector<Entry> result = it->second;
+    auto better = [](const Entry& a, const Entry& b) { return a.count != b.count ? a.count > b.count : a.last > b.last; };
+    if (result.size() > k) {
+        std::partial_sort(result.begin(), result.begin() + k, result.end(), better);
+        result.resize(k);
+    } else {
+        std::sort(result.begin(), result.end(), better);
+    }
+    return result;
+}
+
+inline bool UserHistory::compact()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return rewrite();
+}
+
+// 先写临时文件再改名；按最近选择的先后写出
+inline bool UserHistory::rewrite()
+{
+    if (path_.empty())
+        return false;
+    struct Item { const std::string* code; const Entry* entry; };
+    std::vector<Item> items;
+    items.reserve(entries_);
+    for (const auto& [code, list] : table_)
+        for (const auto& e : list) items.push_back({&code, &e});
+    std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) { return a.entry->last < b.entry->last; });
+
+    std::string tmp = path_ + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+            return false;
+        for (const auto& item : items)
+            out << item.entry->count << '\t' << *item.code << '\t' << utf32_to_utf8(item.entry->text) << '\n';
+        if (!out)
+            return false;
+    }
+    log_.close();
+    std::error_code ec;
+    std::filesystem::rename(tmp, path_, ec);
+    log_.open(path_, std::ios::binary | std::ios::app);
+    if (ec) {
+        std::filesystem::remove(tmp, ec);
+        return false;
+    }
+    log_lines_ = items.size();
+    return true;
+}
+
+inline void UserHistory::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    table_.clear();
+    entries_ = 0;
+    rewrite();
+    version_.fetch_add(1, std::memory_order_release);
+}
+
+inline size_t UserHistory::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_;
+}
@@ -0,0 +1,300 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SCRIPA_UTF_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SCRIPA_UTF_SSE2 1
+#endif
+
+// 转码层：UTF-8 / UTF-32 / UTF-16（wchar_t）互转。
+// 输入码和大部分候选都是 ASCII 或夹着 ASCII，所以每个方向都先用 SIMD 整块跳过 ASCII（AVX2 一次 32 个、SSE2 一次 16 个），
+// 遇到非 ASCII 再逐个码点处理。用哪套指令在编译时决定：x64 至少有 SSE2，开了 /arch:AVX2 或 -mavx2 才用 AVX2。
+// 对非法输入的处理与原来的标量版本一致：非法首字节跳过，末尾不完整的序列丢弃，续字节不校验。
+
+// 把 in 开头连续的 ASCII 扩成 UTF-32，整块处理，返回处理了多少字节（遇到非 ASCII 的块就停）
+inline size_t utf_widen_ascii(const char* in, size_t n, char32_t* out)
+{
+    size_t i = 0;
+#if defined(SCRIPA_UTF_AVX2)
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        if (_mm256_movemask_epi8(v) != 0) break;
+        for (int k = 0; k < 4; ++k) {
+            __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + i + 8 * k));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 8 * k), _mm256_cvtepu8_epi32(bytes));
+        }
+    }
+#endif
+#if defined(SCRIPA_UTF_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        if (_mm_movemask_epi8(v) != 0) break;
+        __m128i lo = _mm_unpacklo_epi8(v, zero);
+        __m128i hi = _mm_unpackhi_epi8(v, zero);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_unpacklo_epi16(lo, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 4), _mm_unpackhi_epi16(lo, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8), _mm_unpacklo_epi16(hi, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 12), _mm_unpackhi_epi16(hi, zero));
+    }
+#endif
+    return i;
+}
+
+// 把 in 开头连续的 ASCII 码点收窄成字节，返回处理了多少码点
+inline size_t utf_narrow_ascii(const char32_t* in, size_t n, char* out)
+{
+    size_t i = 0;
+#if defined(SCRIPA_UTF_SSE2)
+    const __m128i high = _mm_set1_epi32(static_cast<int>(0xFFFFFF80u));
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= n; i += 16) {
+        const __m128i* p = reinterpret_cast<const __m128i*>(in + i);
+        __m128i a = _mm_loadu_si128(p), b = _mm_loadu_si128(p + 1);
+        __m128i c = _mm_loadu_si128(p + 2), d = _mm_loadu_si128(p + 3);
+        __m128i any = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(any, high), zero)) != 0xFFFF) break;
+        __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), bytes);
+    }
+#endif
+    return i;
+}
+
+// 把 in 开头连续的 BMP 码点收窄成 16 位，返回处理了多少码点
+template <class Char16>
+inline size_t utf_narrow_bmp(const char32_t* in, size_t n, Char16* out)
+{
+    static_assert(sizeof(Char16) == 2, "UTF-16 code unit");
+    size_t i = 0;
+#if defined(SCRIPA_UTF_AVX2)
+    const __m256i high32 = _mm256_set1_epi32(static_cast<int>(0xFFFF0000u));
+    for (; i + 16 <= n; i += 16) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i + 8));
+        if (!_mm256_testz_si256(_mm256_or_si256(a, b), high32)) break;
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(a, b), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), packed);
+    }
+#endif
+#if defined(SCRIPA_UTF_SSE2)
+    const __m128i high = _mm_set1_epi32(static_cast<int>(0xFFFF0000u));
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 8 <= n; i += 8) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 4));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(_mm_or_si128(a, b), high), zero)) != 0xFFFF) break;
+        // SSE2 只有有符号饱和的 packs：先把低 16 位符号扩展，打包后正好是原来的低 16 位
+        a = _mm_srai_epi32(_mm_slli_epi32(a, 16), 16);
+        b = _mm_srai_epi32(_mm_slli_epi32(b, 16), 16);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(a, b));
+    }
+#endif
+    return i;
+}
+
+// 一个码点写成 UTF-8，返回字节数
+inline size_t utf_encode_utf8(char32_t cp, char* out)
+{
+    if (cp <= 0x7F) {
+        out[0] = static_cast<char>(cp);
+        return 1;
+    } else if (cp <= 0x7FF) {
+        out[0] = static_cast<char>(0xC0 | ((cp >> 6) & 0x1F));
+        out[1] = static_cast<char>(0x80 | (cp & 0x3F));
+        return 2;
+    } else if (cp <= 0xFFFF) {
+        out[0] = static_cast<char>(0xE0 | ((cp >> 12) & 0x0F));
+        out[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = static_cast<char>(0x80 | (cp & 0x3F));
+        return 3;
+    }
+    out[0] = static_cast<char>(0xF0 | ((cp >> 18) & 0x07));
+    out[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+    out[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    out[3] = static_cast<char>(0x80 | (cp & 0x3F));
+    return 4;
+}
+
+// 解码到调用方给的缓冲区（至少 utf8.size() 个 char32_t），返回写入的码点数，不分配内存
+inline size_t utf8_to_utf32(std::string_view utf8, char32_t* out)
+{
+    size_t count = 0;
+    size_t i = 0, n = utf8.size();
+
+    while (i < n) {
+        size_t run = utf_widen_ascii(utf8.data() + i, n - i, out + count);
+        i += run;
+        count += run;
+        if (i >= n) break;
+
+        unsigned char c = utf8[i];
+        char32_t code = 0;
+        size_t extra = 0;
+
+        if (c < 0x80) {
+            code = c;
+            extra = 0;
+        }
+        else if ((c >> 5) == 0x6) { // 110xxxxx
+            code = c & 0x1F;
+            extra = 1;
+        }
+        else if ((c >> 4) == 0xE) { // 1110xxxx
+            code = c & 0x0F;
+            extra = 2;
+        }
+        else if ((c >> 3) == 0x1E) { // 11110xxx
+            code = c & 0x07;
+            extra = 3;
+        }
+        else {
+            // invalid byte
+            ++i;
+            continue;
+        }
+
+        if (i + extra >= n) break;
+
+        for (size_t j = 1; j <= extra; ++j) {
+            unsigned char cc = utf8[i + j];
+            code = (code << 6) | (cc & 0x3F);
+        }
+
+        out[count++] = code;
+        i += extra + 1;
+    }
+    return count;
+}
+
+inline std::u32string utf8_to_utf32(const std::string& utf8) //把8位变成32位
+{
+    std::u32string out(utf8.size(), U'\0');
+    out.resize(utf8_to_utf32(std::string_view(utf8), &out[0]));
+    return out;
+}
+
+// 追加到 out 末尾，批量输出时不用为每个候选建临时字符串
+inline void utf32_append_utf8(std::u32string_view in, std::string& out)
+{
+    // 大多数候选只有几个码点：在栈上编码好再一次追加，省得按 4 倍上限扩容再缩回
+    if (in.size() <= 16) {
+        char buf[64];
+        size_t len = 0;
+        for (char32_t cp : in) len += utf_encode_utf8(cp, buf + len);
+        out.append(buf, len);
+        return;
+    }
+    const size_t base = out.size();
+    out.resize(base + in.size() * 4);
+    char* p = &out[base];
+    size_t i = 0;
+    while (i < in.size()) {
+        size_t run = utf_narrow_ascii(in.data() + i, in.size() - i, p);
+        i += run;
+        p += run;
+        if (i >= in.size()) break;
+        p += utf_encode_utf8(in[i++], p);
+    }
+    out.resize(p - out.data());
+}
+
+inline std::string utf32_to_utf8(std::u32string_view in)
+{
+    std::string out;
+    utf32_append_utf8(in, out);
+    return out;
+}
+
+// utf32_to_utf8(in) == utf8，但不生成中间字符串
+inline bool utf32_equals_utf8(std::u32string_view in, std::string_view utf8)
+{
+    size_t pos = 0;
+    for (char32_t cp : in) {
+        char buf[4];
+        size_t len = utf_encode_utf8(cp, buf);
+        if (utf8.size() - pos < len || utf8.compare(pos, len, buf, len) != 0)
+            return false;
+        pos += len;
+    }
+    return pos == utf8.size();
+}
+
+// UTF-32 直接转 UTF-16，不经过 UTF-8。out 至少要有 2 * in.size() 个单元，返回写入的单元数
+template <class Char16>
+inline size_t utf32_to_utf16(std::u32string_view in, Char16* out)
+{
+    size_t count = 0;
+    size_t i = 0;
+    while (i < in.size()) {
+        size_t run = utf_narrow_bmp(in.data() + i, in.size() - i, out + count);
+        i += run;
+        count += run;
+        if (i >= in.size()) break;
+        char32_t cp = in[i++];
+        if (cp >= 0x10000 && cp <= 0x10FFFF) {
+            cp -= 0x10000;
+            out[count++] = static_cast<Char16>(0xD800 + (cp >> 10));
+            out[count++] = static_cast<Char16>(0xDC00 + (cp & 0x3FF));
+        } else if (cp > 0x10FFFF) {
+            out[count++] = static_cast<Char16>(0xFFFD);
+        } else {
+            out[count++] = static_cast<Char16>(cp);
+        }
+    }
+    return count;
+}
+
+inline std::u16string utf32_to_utf16(std::u32string_view in)
+{
+    std::u16string out(in.size() * 2, u'\0');
+    out.resize(utf32_to_utf16(in, &out[0]));
+    return out;
+}
+
+// wchar_t 在 Windows 上是 UTF-16，在其他平台上是 UTF-32
+inline std::wstring utf32_to_wstring(std::u32string_view in)
+{
+    if constexpr (sizeof(wchar_t) == 2) {
+        std::wstring out(in.size() * 2, L'\0');
+        out.resize(utf32_to_utf16(in, &out[0]));
+        return out;
+    } else {
+        return std::wstring(in.begin(), in.end());
+    }
+}
+
+inline std::wstring utf8_to_wstring(std::string_view utf8)
+{
+    std::u32string wide(utf8.size(), U'\0');
+    wide.resize(utf8_to_utf32(utf8, &wide[0]));
+    return utf32_to_wstring(wide);
+}
+
+inline std::string wstring_to_utf8(std::wstring_view in)
+{
+    std::string out;
+    out.reserve(in.size());
+    char buf[4];
+    for (size_t i = 0; i < in.size(); ++i) {
+        char32_t cp = static_cast<char32_t>(in[i]);
+        if constexpr (sizeof(wchar_t) == 2) {
+            cp &= 0xFFFF;
+            if (cp >= 0xD800 && cp <= 0xDBFF && i + 1 < in.size()) {
+                char32_t lo = static_cast<char32_t>(in[i + 1]) & 0xFFFF;
+                if (lo >= 0xDC00 && lo <= 0xDFFF) {
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                    ++i;
+                }
+            }
+        }
+        out.append(buf, utf_encode_utf8(cp, buf));
+    }
+    return out;
+}
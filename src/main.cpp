@@ -1,11 +1,24 @@
 #include "core/Dic.hpp"
 #include "core/Engine.hpp"
 #include "core/Loader.hpp"
+#include "core/UserHistory.hpp"
+#include "core/Trace.hpp"
+#include "core/SchemeWatcher.hpp"
 #include <iostream>
+#include <fstream>
 #include <string>
+#include <string_view>
+#include <vector>
+#include <cctype>
+#include <cstdlib>
 #include <algorithm>
+#include <memory>
+#include <atomic>
 #ifdef _WIN32
 #include <windows.h>
+#else
+#include <sys/ioctl.h>
+#include <unistd.h>
 #endif
 
 // status-line helper: print a single-line status that overwrites previous status
@@ -43,24 +56,211 @@ static void printStatusLine(const std::string& s) {
     g_last_status_len = out.size();
 }
 
-int main() {
+// Batch mode: every whitespace-separated token is converted on its own, exactly like
+// typing it and pressing Space. top_k == 1 keeps the line layout and writes the best
+// candidate per token; top_k > 1 writes one TSV row per token: input, then candidates.
+// Lines are read in blocks; each block's tokens go through Converter::convertBatch on
+// `jobs` threads sharing the one read-only Dictionary, and are written back in input order.
+static void transliterateStream(const Dictionary& dict, std::istream& in, std::string& out,
+                                size_t top_k, unsigned jobs, size_t beam)
+{
+    const size_t kBlockLines = 1 << 14;
+    std::vector<std::string> lines;
+    std::vector<std::string_view> tokens;
+    std::vector<size_t> line_tokens;  // 每行的 token 数
+
+    auto flushBlock = [&]() {
+        // lines 在这之后不再变动，token 可以直接指向其中
+        for (const auto& l : lines) {
+            size_t i = 0, count = 0;
+            while (i < l.size()) {
+                while (i < l.size() && std::isspace((unsigned char)l[i])) ++i;
+                if (i >= l.size()) break;
+                size_t j = i;
+                while (j < l.size() && !std::isspace((unsigned char)l[j])) ++j;
+                tokens.push_back(std::string_view(l).substr(i, j - i));
+                ++count;
+                i = j;
+            }
+            line_tokens.push_back(count);
+        }
+        auto results = Converter::convertBatch(dict, tokens, top_k, jobs, beam);
+        size_t t = 0;
+        for (size_t count : line_tokens) {
+            for (size_t k = 0; k < count; ++k, ++t) {
+                const auto& cand = results[t];
+                if (top_k == 1) {
+                    if (k > 0) out += ' ';
+                    if (cand.empty()) out.append(tokens[t]);
+                    else utf32_append_utf8(cand[0], out);
+                } else {
+                    out.append(tokens[t]);
+                    for (const auto& c : cand) {
+                        out += '\t';
+                        utf32_append_utf8(c, out);
+                    }
+                    out += '\n';
+                }
+            }
+            if (top_k == 1) out += '\n';
+        }
+        std::cout.write(out.data(), (std::streamsize)out.size());
+        out.clear();
+        lines.clear();
+        tokens.clear();
+        line_tokens.clear();
+    };
+
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        lines.push_back(std::move(line));
+        if (lines.size() == kBlockLines) flushBlock();
+    }
+    flushBlock();
+}
+
+static int runBatch(const std::string& schemesDir, size_t top_k, unsigned jobs, size_t beam,
+                    const std::vector<std::string>& files)
+{
+    std::ios::sync_with_stdio(false);
+    Dictionary dict;
+    SchemeLoader loader;
+    // 加载日志写到 stderr，stdout 只留转换结果
+    std::streambuf* out_buf = std::cout.rdbuf(std::cerr.rdbuf());
+    int count = loader.loadSchemes(schemesDir, dict);
+    std::cout.rdbuf(out_buf);
+    if (count == 0) {
+        std::cerr << "No scheme files loaded from " << schemesDir << "\n";
+        return 1;
+    }
+
+    std::string out;
+    int status = 0;
+    if (files.empty()) {
+        transliterateStream(dict, std::cin, out, top_k, jobs, beam);
+    }
+    for (const auto& path : files) {
+        std::ifstream fin(path);
+        if (!fin.is_open()) {
+            std::cerr << "Failed to open input file: " << path << "\n";
+            status = 1;
+            continue;
+        }
+        transliterateStream(dict, fin, out, top_k, jobs, beam);
+    }
+    std::cout.flush();
+    if (Trace::kEnabled) Trace::dump(std::cerr);  // stdout 只留转换结果
+    return status;
+}
+
+static void printUsage(const char* argv0)
+{
+    std::cerr << "Usage: " << argv0 << " [--batch [--top K] [--jobs N] [--schemes DIR] [FILE...]] [--beam B]\n"
+              << "  (no options)   interactive mode; edited scheme files are reloaded while typing\n"
+              << "  --batch        convert FILEs (or stdin) token by token, best candidate per token\n"
+              << "  --top K        write K candidates per token as TSV: input<TAB>cand1<TAB>...\n"
+              << "  --jobs N       worker threads for batch mode (default: all cores)\n"
+              << "  --schemes DIR  scheme directory (default: schemes/)\n"
+              << "  --beam B       beam search keeping B hypotheses per position: linear time for very long\n"
+              << "                 input, at most B candidates, not guaranteed exact (default 0: exact search)\n"
+              << "  --history FILE interactive mode: rank candidates chosen before first, and record choices in FILE\n";
+}
+
+int main(int argc, char** argv) {
     // Ensure Windows console uses UTF-8 so IPA characters render correctly
 #ifdef _WIN32
     SetConsoleOutputCP(CP_UTF8);
     SetConsoleCP(CP_UTF8);
     // Keep input echo enabled so user sees typed ASCII buffer.
 #endif
-    Dictionary dict;
+    bool batch = false;
+    size_t top_k = 1;
+    unsigned jobs = 0;
+    size_t beam = 0;
+    std::string schemesDir = "schemes/";
+    std::string historyPath;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--batch") {
+            batch = true;
+        } else if (arg == "--top" && i + 1 < argc) {
+            long v = std::atol(argv[++i]);
+            top_k = v > 0 ? (size_t)v : 1;
+        } else if (arg == "--jobs" && i + 1 < argc) {
+            long v = std::atol(argv[++i]);
+            jobs = v > 0 ? (unsigned)v : 0;
+        } else if (arg == "--beam" && i + 1 < argc) {
+            long v = std::atol(argv[++i]);
+            beam = v > 0 ? (size_t)v : 0;
+        } else if (arg == "--schemes" && i + 1 < argc) {
+            schemesDir = argv[++i];
+        } else if (arg == "--history" && i + 1 < argc) {
+            historyPath = argv[++i];
+        } else if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (!arg.empty() && arg[0] == '-' && arg != "-") {
+            printUsage(argv[0]);
+            return 1;
+        } else if (arg != "-") {
+            files.push_back(arg);
+        }
+    }
+    if (batch) {
+        return runBatch(schemesDir, top_k, jobs, beam, files);
+    }
+
+    // 字库目录里的文件一改，监视线程只置一个标记；主循环在下一次按键时接过当前的各层重建一份字典换上，
+    // 输入中的 buffer 保留。重建与输出都在主循环里，不与状态行的刷新抢
+    std::atomic<bool> schemesChanged{false};
     SchemeLoader loader;
-    int count = loader.loadSchemes("schemes/", dict);
+    std::shared_ptr<const Dictionary> dict;
+    auto buildDictionary = [&](int& count) {
+        auto next = std::make_shared<Dictionary>();
+        if (dict)
+            next->setLayers(dict->layers());
+        count = loader.loadSchemes(schemesDir, *next);
+        return next;
+    };
+    int count = 0;
+    dict = buildDictionary(count);
     std::cout << "Loaded scheme files: " << count << "\n";
-    Engine engine(&dict);
+    Engine engine(dict.get());
+    engine.setBeamWidth(beam);
+    UserHistory history;
+    if (!historyPath.empty()) {
+        history.open(historyPath);
+        engine.setHistory(&history);
+    }
+
+    SchemeWatcher watcher(schemesDir, [&] { schemesChanged.store(true); });
 
     std::cout << "Type characters; press Space to commit first candidate. Ctrl+C to exit.\n";
+    if (Trace::kEnabled)
+        std::cout << "Ctrl+T prints per-stage latencies; they are also printed on end of input (Ctrl+D / Ctrl+Z).\n";
 
     while (true) {
         char c;
         if (!std::cin.get(c)) break; // read including spaces
+        if (schemesChanged.exchange(false)) {
+            int reloaded = 0;
+            auto next = buildDictionary(reloaded);
+            // 文件删改到一半、一个字库都没读到时保留旧字典
+            if (reloaded > 0) {
+                dict = std::move(next);
+                engine.setDictionary(dict.get());
+                std::cout << "\nReloaded scheme files after a change: " << reloaded << "\n" << std::flush;
+                g_last_status_len = 0;
+            }
+        }
+        if (Trace::kEnabled && c == '\x14') {  // Ctrl+T
+            std::cout << '\n';
+            Trace::dump(std::cout);
+            g_last_status_len = 0;
+            continue;
+        }
         // Handle special commit keys (space / Enter) in IPA mode BEFORE feeding char to engine
         if (engine.getMode() == Engine::Mode::IPA && (c == ' ' || c == '\r' || c == '\n')) {
             auto cand = engine.getCandidates();
@@ -74,6 +274,7 @@ int main() {
                 }
 
                 size_t chosen_index = 0;
+                bool picked = false;  // 从列表里输了编号；直接回车/空格取首选不记进选词记录
                 if (cand.size() == 1) {
                     chosen_index = 0;
                 } else {
@@ -100,15 +301,17 @@ int main() {
                     } else {
                         try {
                             int v = std::stoi(selline);
-                            if (v >= 1 && static_cast<size_t>(v) <= cand.size()) chosen_index = static_cast<size_t>(v - 1);
-                            else chosen_index = 0;
+                            if (v >= 1 && static_cast<size_t>(v) <= cand.size()) {
+                                chosen_index = static_cast<size_t>(v - 1);
+                                picked = true;
+                            } else chosen_index = 0;
                         } catch (...) {
                             chosen_index = 0;
                         }
                     }
                 }
 
-                auto res = engine.chooseCandidate(chosen_index);
+                auto res = engine.chooseCandidate(chosen_index, picked);
                 std::string out = utf32_to_utf8(res);
                 // clear status line fully, then print committed candidate on its own line
                 std::cout << '\r';
@@ -147,5 +350,9 @@ int main() {
         printStatusLine(status);
     }
 // done
+    if (Trace::kEnabled) {
+        std::cout << '\n';
+        Trace::dump(std::cout);
+    }
     return 0;
 }
\ No newline at end of file
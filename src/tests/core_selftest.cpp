@@ -0,0 +1,477 @@
+// 核心自检：只依赖 src/core，逐项检查过去出过问题的行为，失败时打印原因并返回非零。
+//
+// 构建（在仓库根目录）:
+//   g++ -std=c++17 -O2 -pthread -Isrc src/tests/core_selftest.cpp -o core_selftest
+//   cl /std:c++17 /O2 /utf-8 /EHsc /I src src\tests\core_selftest.cpp
+// 运行:
+//   core_selftest [schemes_dir] [filter]
+//   schemes_dir 默认为 schemes/；filter 只跑名字里含该子串的项
+#include "core/Dic.hpp"
+#include "core/Converter.hpp"
+#include "core/CandidateWorker.hpp"
+#include "core/Loader.hpp"
+#include "core/SchemeWatcher.hpp"
+#include "core/UserHistory.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <string>
+#include <vector>
+
+static std::string g_schemes = "schemes/";
+static std::string g_filter;
+static int g_failed = 0;
+static bool g_ok = true;
+
+#define CHECK(cond)                                                                   \
+    do {                                                                              \
+        if (!(cond)) {                                                                \
+            std::printf("    %s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+            g_ok = false;                                                             \
+        }                                                                             \
+    } while (0)
+
+static void run(const std::string& name, const std::function<void()>& body)
+{
+    if (!g_filter.empty() && name.find(g_filter) == std::string::npos)
+        return;
+    g_ok = true;
+    body();
+    std::printf("%-40s %s\n", name.c_str(), g_ok ? "ok" : "FAILED");
+    std::fflush(stdout);
+    if (!g_ok) ++g_failed;
+}
+
+// 与 SchemeLoader 一样以字库名（不含扩展名）作层名
+static bool loadScheme(Dictionary& dict, const std::string& name)
+{
+    SchemeImageBuilder builder;
+    builder.beginScheme(name);
+    if (!Dictionary::parseSchemeText((std::filesystem::path(g_schemes) / (name + ".txt")).string(), builder))
+        return false;
+    return dict.loadScheme(SchemeImage::fromBytes(builder.finish()), 0);
+}
+
+// 用一段文本现场写一个字库文件再加载，层名为 name
+static bool loadSchemeText(Dictionary& dict, const std::string& name, const std::string& text)
+{
+    const auto path = std::filesystem::temp_directory_path() / ("scripa_selftest_" + name + ".txt");
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << text;
+    }
+    SchemeImageBuilder builder;
+    builder.beginScheme(name);
+    const bool ok = Dictionary::parseSchemeText(path.string(), builder);
+    std::filesystem::remove(path);
+    return ok && dict.loadScheme(SchemeImage::fromBytes(builder.finish()), 0);
+}
+
+static std::vector<std::u32string> convert(const Dictionary& dict, const std::string& code, size_t k)
+{
+    Converter conv(&dict);
+    conv.assign(code);
+    return conv.candidates(k);
+}
+
+static bool contains(const std::vector<std::u32string>& list, std::u32string_view text)
+{
+    return std::find(list.begin(), list.end(), text) != list.end();
+}
+
+static std::u32string repeat(std::u32string_view s, size_t n)
+{
+    std::u32string out;
+    for (size_t i = 0; i < n; ++i) out += s;
+    return out;
+}
+
+// 固定种子的随机输入码：可见 ASCII，长 1..max_len（线性同余，各平台一致）
+static std::vector<std::string> randomCodes(uint32_t seed, size_t count, size_t max_len)
+{
+    std::vector<std::string> codes(count);
+    auto next = [&seed] {
+        seed = seed * 1664525u + 1013904223u;
+        return seed >> 8;
+    };
+    for (auto& code : codes) {
+        const size_t len = 1 + next() % max_len;
+        for (size_t i = 0; i < len; ++i) code += static_cast<char>('!' + next() % 94);
+    }
+    return codes;
+}
+
+// 候选列表的指纹（FNV-1a），候选之间、列表之间各插一个分隔
+static uint64_t listsFingerprint(const Dictionary& dict, const std::vector<std::string>& codes, size_t k)
+{
+    uint64_t h = 0xCBF29CE484222325ULL;
+    auto mix = [&h](uint32_t v) { h = (h ^ v) * 0x100000001B3ULL; };
+    Converter conv(&dict);
+    for (const auto& code : codes) {
+        conv.assign(code);
+        for (const auto& c : conv.candidates(k)) {
+            for (char32_t ch : c) mix(ch);
+            mix(0xFFFFFFFFu);
+        }
+        mix(0xFFFFFFFEu);
+    }
+    return h;
+}
+
+static double secondsSince(std::chrono::steady_clock::time_point t0)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// ---- 用例 ----
+
+// 同分的切分很多时（ub 可以是 ɯ、ʊ 或原样），候选要逐个按码点序出，不能先把整组同分的展开
+static void longTies()
+{
+    Dictionary dict;
+    CHECK(loadScheme(dict, "default"));
+    std::string code;
+    for (int i = 0; i < 200; ++i) code += "ub";
+    Converter conv(&dict);
+    auto t0 = std::chrono::steady_clock::now();
+    conv.assign(code);
+    auto top = conv.candidates(5);
+    CHECK(secondsSince(t0) < 1.0);
+    CHECK(top.size() == 5);
+    if (top.size() == 5) {
+        CHECK(top[0] == repeat(U"ɯ", 200));
+        CHECK(top[1] == repeat(U"ɯ", 199) + U"ʊ");
+        CHECK(top[2] == repeat(U"ɯ", 198) + U"ʊɯ");
+        for (size_t i = 1; i < top.size(); ++i) CHECK(top[i - 1] < top[i]);
+    }
+}
+
+// 随便敲的一长串：每一段都有好几种切法
+static void longMixed()
+{
+    Dictionary dict;
+    CHECK(loadScheme(dict, "default"));
+    std::string code;
+    uint32_t x = 12345;
+    for (int i = 0; i < 2000; ++i) {
+        x = x * 1103515245u + 12345u;
+        code += static_cast<char>('a' + (x >> 16) % 26);
+    }
+    Converter conv(&dict);
+    auto t0 = std::chrono::steady_clock::now();
+    conv.assign(code);
+    auto top = conv.candidates(3);
+    CHECK(secondsSince(t0) < 1.0);
+    CHECK(top.size() == 3);
+}
+
+// 束搜索同分时按码点序取舍，留下的就是精确搜索排在最前的那些
+static void beamMatchesExact()
+{
+    Dictionary dict;
+    CHECK(loadScheme(dict, "default"));
+    std::string code;
+    for (int i = 0; i < 20; ++i) code += "ub";
+    Converter exact(&dict), beam(&dict);
+    beam.setBeamWidth(16);
+    exact.assign(code);
+    beam.assign(code);
+    auto want = exact.candidates(16);
+    auto got = beam.candidates(16);
+    CHECK(!got.empty() && got[0] == repeat(U"ɯ", 20));
+    CHECK(got == want);
+}
+
+// 调号由 tones 字库生成：没加载它时 T 与数字就是普通的输入码
+static void tonesNeedScheme()
+{
+    Dictionary with, without;
+    CHECK(loadScheme(with, "default"));
+    CHECK(loadScheme(with, "tones"));
+    CHECK(loadScheme(without, "default"));
+    auto on = convert(with, "ubT51", 10);
+    CHECK(!on.empty() && on[0] == U"ɯ˥˩");
+    auto off = convert(without, "ubT51", 10);
+    CHECK(!contains(off, U"ɯ˥˩"));
+    CHECK(!off.empty() && off[0] == U"ɯT51");
+    // Dictionary::load 直接加载的层名是文件路径，也认得出是 tones
+    Dictionary direct;
+    CHECK(direct.load((std::filesystem::path(g_schemes) / "default.txt").string()));
+    CHECK(direct.load((std::filesystem::path(g_schemes) / "tones.txt").string()));
+    auto loaded = convert(direct, "ubT51", 10);
+    CHECK(!loaded.empty() && loaded[0] == U"ɯ˥˩");
+    // 数字整段归一个调号，TnT 键（T1T ꜌）后面的数字不再单独拆出来
+    CHECK(convert(with, "T1T2", 10) == (std::vector<std::u32string>{U"꜑꜐", U"T1T2"}));
+    // 卸掉 tones 以后同一个 Converter 也不再生成
+    Converter conv(&with);
+    conv.assign("T3");
+    CHECK(contains(conv.candidates(10), U"꜏"));
+    with.removeLayer("tones");
+    conv.assign("T3");
+    CHECK(!contains(conv.candidates(10), U"꜏"));
+}
+
+// 原样输出段可以跨过调号（xT3y、T3y）；整段正好是调号时不原样输出，单独的 T3 只有调符
+static void toneLiteral()
+{
+    Dictionary dict;
+    CHECK(loadScheme(dict, "default"));
+    CHECK(loadScheme(dict, "tones"));
+    CHECK(convert(dict, "T3", 10) == (std::vector<std::u32string>{U"꜏"}));
+    CHECK(convert(dict, "T3y", 10) == (std::vector<std::u32string>{U"꜏y", U"T3y"}));
+    CHECK(convert(dict, "xT3y", 10) == (std::vector<std::u32string>{U"x꜏y", U"xT3y"}));
+}
+
+// 键与值相同的单字符（a a）在更长的原样输出段里照样拼得出来：xa、xay 各是一段
+static void identityIsRaw()
+{
+    Dictionary dict;
+    CHECK(loadSchemeText(dict, "custom", "a a\nb β\nyb ψ\n"));
+    CHECK(convert(dict, "xayb", 10) == (std::vector<std::u32string>{U"xayβ", U"xaψ", U"xayb"}));
+}
+
+// 原样输出段改成逐字符续写以后，候选与之前每个起点各加一条原样输出边时完全一致：
+// 整段是键的不原样输出（L 只有 ː），指纹取自改动之前的实现
+static void passThroughMatchesPrevious()
+{
+    Dictionary dict;
+    for (const char* name : {"chinese", "default", "simple", "tones"}) CHECK(loadScheme(dict, name));
+    CHECK(convert(dict, "L", 20) == (std::vector<std::u32string>{U"ː"}));
+    CHECK(convert(dict, "D.W", 20) == (std::vector<std::u32string>{U"◌̣◌͡", U"◌̩.◌͡", U"◌̩.W", U"D.W"}));
+    CHECK(convert(dict, "//hqnc", 20) == (std::vector<std::u32string>{U"hɴc", U"hqnc", U"//ʔnc", U"//hɴc", U"//hqnc"}));
+    CHECK(listsFingerprint(dict, randomCodes(2025, 4000, 12), 20) == 0xe5b401f65a1578a1ULL);
+}
+
+// 空格直接提交首选不记进选词记录，从列表里挑的才记，否则首选一经提交就永远排在最前
+static void historyRecordsPicksOnly()
+{
+    Dictionary dict;
+    CHECK(loadScheme(dict, "default"));
+    UserHistory history;  // 不打开日志文件，只记在内存里
+    Engine engine(&dict);
+    engine.setHistory(&history);
+    auto type = [&](const char* code) {
+        for (const char* p = code; *p; ++p) engine.inputChar(*p);
+    };
+    type("ub");
+    CHECK(engine.chooseCandidate(0, false) == U"ɯ");
+    CHECK(history.size() == 0);
+    type("ub");
+    CHECK(engine.chooseCandidate(1) == U"ʊ");
+    CHECK(history.size() == 1);
+    type("ub");
+    auto cand = engine.getCandidates();
+    CHECK(!cand.empty() && cand[0] == U"ʊ");
+}
+
+// ---- 后台候选计算 ----
+
+// 工作线程交回的结果，测试线程在这里等
+struct WorkerInbox {
+    std::mutex mutex;
+    std::condition_variable arrived;
+    std::vector<CandidateWorker::Result> results;
+
+    CandidateWorker::Callback callback()
+    {
+        return [this](CandidateWorker::Result&& r) {
+            std::lock_guard<std::mutex> lock(mutex);
+            results.push_back(std::move(r));
+            arrived.notify_all();
+        };
+    }
+    // 等到收到 tag 的结果；超时返回 false
+    bool waitFor(uint64_t tag, double seconds)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        return arrived.wait_for(lock, std::chrono::duration<double>(seconds), [&] {
+            return std::any_of(results.begin(), results.end(), [&](const auto& r) { return r.tag == tag; });
+        });
+    }
+    size_t count()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return results.size();
+    }
+};
+
+static std::shared_ptr<const Dictionary> defaultDictionary()
+{
+    auto dict = std::make_shared<Dictionary>();
+    CHECK(loadScheme(*dict, "default"));
+    return dict;
+}
+
+// ub 重复 12 次有 3^12 个候选，全要的话要算好几秒
+static CandidateWorker::Request longRequest(uint64_t tag, std::shared_ptr<const Dictionary> dict)
+{
+    std::string code;
+    for (int i = 0; i < 12; ++i) code += "ub";
+    return {tag, std::move(dict), code, {}, 1000000, 0};
+}
+
+// 正在算的长请求被新请求打断：新请求很快就有结果，旧的不交回
+static void workerInterrupt()
+{
+    auto dict = defaultDictionary();
+    WorkerInbox inbox;
+    CandidateWorker worker(inbox.callback());
+    worker.submit(longRequest(1, dict));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    auto t0 = std::chrono::steady_clock::now();
+    worker.submit({2, dict, "ub", {}, 10, 0});
+    CHECK(inbox.waitFor(2, 5.0));
+    CHECK(secondsSince(t0) < 1.0);
+    worker.cancel();
+    std::lock_guard<std::mutex> lock(inbox.mutex);
+    CHECK(inbox.results.size() == 1);
+    if (!inbox.results.empty()) {
+        CHECK(inbox.results[0].tag == 2);
+        CHECK(inbox.results[0].items == (std::vector<std::u32string>{U"ɯ", U"ʊ", U"ub"}));
+        CHECK(inbox.results[0].complete);
+    }
+}
+
+// 逐字输入（夹着退格）时连续提交：被取代的结果不再交回，交回的 tag 只增不减，最后一个与同步计算的相同
+static void workerDropsStale()
+{
+    auto dict = defaultDictionary();
+    WorkerInbox inbox;
+    CandidateWorker worker(inbox.callback());
+    const std::string typed = "shiubaxnTbu";
+    std::string code;
+    uint64_t tag = 0;
+    for (char c : typed) {
+        code += c;
+        worker.submit({++tag, dict, code, {}, 60, 0});
+        if (c == 'x') {
+            code.pop_back();
+            worker.submit({++tag, dict, code, {}, 60, 0});
+        }
+    }
+    CHECK(inbox.waitFor(tag, 5.0));
+    worker.cancel();
+
+    Converter conv(dict.get());
+    auto want = Engine::candidatesFor(conv, code, {}, 60);
+    std::lock_guard<std::mutex> lock(inbox.mutex);
+    CHECK(!inbox.results.empty() && inbox.results.back().tag == tag);
+    for (size_t i = 1; i < inbox.results.size(); ++i) CHECK(inbox.results[i - 1].tag < inbox.results[i].tag);
+    if (!inbox.results.empty()) CHECK(inbox.results.back().items == want);
+}
+
+// 关闭：析构时正在算的请求要尽快停下，之后不再回调
+static void workerShutdown()
+{
+    auto dict = defaultDictionary();
+    WorkerInbox inbox;
+    auto worker = std::make_unique<CandidateWorker>(inbox.callback());
+    worker->submit(longRequest(1, dict));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    auto t0 = std::chrono::steady_clock::now();
+    worker.reset();
+    CHECK(secondsSince(t0) < 1.0);
+    CHECK(inbox.count() == 0);
+
+    // cancel 之后同一个 worker 还能接着用
+    CandidateWorker again(inbox.callback());
+    again.submit(longRequest(2, dict));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    t0 = std::chrono::steady_clock::now();
+    again.cancel();
+    CHECK(secondsSince(t0) < 1.0);
+    again.submit({3, dict, "ub", {}, 10, 0});
+    CHECK(inbox.waitFor(3, 5.0));
+    CHECK(inbox.count() == 1);
+}
+
+// ---- 字库热重载 ----
+
+// 与交互模式（src/main.cpp）相同的接法：监视线程接过当前的各层重建字典并发布。
+// 改一个字库文件之后应该在几秒内看到新快照，新快照里有改过的值
+static void watcherPublishesSnapshot()
+{
+    namespace fs = std::filesystem;
+    const fs::path dir = fs::temp_directory_path() / "scripa_selftest_watch";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    auto write = [&](const char* text) {
+        std::ofstream out(dir / "custom.txt", std::ios::binary | std::ios::trunc);
+        out << text;
+    };
+    write("ab α\n");
+
+    // 加载日志不进测试输出
+    std::ostringstream log;
+    std::streambuf* out_buf = std::cout.rdbuf(log.rdbuf());
+    {
+        SharedDictionary shared;
+        SchemeLoader loader;
+        auto build = [&](int& count) {
+            auto dict = std::make_shared<Dictionary>();
+            if (auto current = shared.load())
+                dict->setLayers(current->layers());
+            count = loader.loadSchemes(dir.string(), *dict);
+            return dict;
+        };
+        int count = 0;
+        shared.publish(build(count));
+        CHECK(count == 1);
+        auto first = shared.load();
+        CHECK(convert(*first, "ab", 1) == std::vector<std::u32string>{U"α"});
+
+        SchemeWatcher watcher(dir.string(), [&] {
+            int reloaded = 0;
+            auto next = build(reloaded);
+            if (reloaded > 0) shared.publish(std::move(next));
+        });
+        CHECK(watcher.watching());
+        write("ab β\n");
+
+        // 轮询的平台每秒才比一次，还要连续两次一致
+        auto t0 = std::chrono::steady_clock::now();
+        while (shared.load() == first && secondsSince(t0) < 5.0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        auto next = shared.load();
+        CHECK(next != first);
+        CHECK(convert(*next, "ab", 1) == std::vector<std::u32string>{U"β"});
+        CHECK(convert(*first, "ab", 1) == std::vector<std::u32string>{U"α"});  // 已发布的快照不变
+    }
+    std::cout.rdbuf(out_buf);
+    fs::remove_all(dir);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 1) g_schemes = argv[1];
+    if (argc > 2) g_filter = argv[2];
+
+    run("converter/long-ties", longTies);
+    run("converter/long-mixed", longMixed);
+    run("converter/beam-matches-exact", beamMatchesExact);
+    run("converter/tones-need-scheme", tonesNeedScheme);
+    run("converter/tone-literal", toneLiteral);
+    run("converter/identity-is-raw", identityIsRaw);
+    run("converter/pass-through-matches-previous", passThroughMatchesPrevious);
+    run("engine/history-records-picks-only", historyRecordsPicksOnly);
+    run("worker/interrupt", workerInterrupt);
+    run("worker/drops-stale", workerDropsStale);
+    run("worker/shutdown", workerShutdown);
+    run("watcher/publishes-snapshot", watcherPublishesSnapshot);
+
+    if (g_failed) {
+        std::printf("%d failed\n", g_failed);
+        return 1;
+    }
+    std::printf("all passed\n");
+    return 0;
+}
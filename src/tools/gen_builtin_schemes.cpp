@@ -0,0 +1,354 @@
+// 把自带的字库编成常量数据：每个字库一节，输入码前缀树的节点用最小完美哈希定位，值表按码点排好序，
+// 生成的头文件（src/core/BuiltinSchemes.hpp）直接编进程序，Dictionary 查表时不解析、不分配（见 StaticSchemes）。
+// 自带字库随版本发布才会改，改了以后重新生成；没重新生成时 SchemeLoader 发现文件与表里的指纹不同，会照旧加载 .txt。
+//
+// 构建并生成（在仓库根目录）:
+//   g++ -std=c++17 -O2 -Isrc src/tools/gen_builtin_schemes.cpp -o gen_builtin_schemes
+//   ./gen_builtin_schemes schemes src/core/BuiltinSchemes.hpp chinese default simple tones
+// 参数：字库目录、输出文件、要编进去的字库名（不含 .txt）。custom 是用户自己编辑的，不要编进去。
+// 加 --check 只比较不写：输出与现有文件不同就返回 1（bat/build_tsf.bat 编译 DLL 前这样检查，不改动仓库里的文件）。
+#include "core/Dic.hpp"
+#include "core/SchemeImage.hpp"
+#include "core/Utf.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct SchemeSource {
+    std::string name;
+    std::string bytes;
+    std::unique_ptr<Dictionary> dict;  // 只含这一个字库，键的候选已按文件顺序去重
+    std::vector<std::string> keys;
+};
+
+static bool readFile(const std::string& path, std::string& out)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+    std::stringstream ss;
+    ss << in.rdbuf();
+    out = ss.str();
+    return true;
+}
+
+// 键与 scheme 名按字节写成普通字符串字面量；非 ASCII 用三位八进制，不会像 \x 那样吞掉后面的字符
+static std::string quoteBytes(std::string_view s)
+{
+    std::string out = "\"";
+    char buf[8];
+    for (char ch : s) {
+        unsigned char c = static_cast<unsigned char>(ch);
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += ch;
+        } else if (c >= 0x20 && c < 0x7F && c != '?') {
+            out += ch;
+        } else {
+            std::snprintf(buf, sizeof(buf), "\\%03o", c);
+            out += buf;
+        }
+    }
+    return out + "\"";
+}
+
+static std::string quoteValue(std::u32string_view s)
+{
+    std::string out = "U\"";
+    char buf[16];
+    for (char32_t c : s) {
+        if (c >= 0x20 && c < 0x7F && c != '"' && c != '\\' && c != '?') {
+            out += static_cast<char>(c);
+        } else {
+            std::snprintf(buf, sizeof(buf), "\\U%08X", static_cast<unsigned>(c));
+            out += buf;
+        }
+    }
+    return out + "\"";
+}
+
+int main(int argc, char** argv)
+{
+    const bool checkOnly = argc > 1 && std::string(argv[1]) == "--check";
+    if (checkOnly) {
+        --argc;
+        ++argv;
+    }
+    if (argc < 4) {
+        std::cerr << "Usage: " << argv[0] << " [--check] SCHEMES_DIR OUT_HEADER SCHEME...\n";
+        return 2;
+    }
+    const std::string dir = argv[1];
+    const std::string outPath = argv[2];
+    if (argc - 3 > static_cast<int>(StaticSchemes::kMaxSchemes)) {
+        std::cerr << "At most " << StaticSchemes::kMaxSchemes << " schemes\n";
+        return 2;
+    }
+
+    std::vector<SchemeSource> sources;
+    for (int i = 3; i < argc; ++i) {
+        SchemeSource src;
+        src.name = argv[i];
+        std::string path = (std::filesystem::path(dir) / (src.name + ".txt")).string();
+        if (!readFile(path, src.bytes)) {
+            std::cerr << "Cannot read " << path << "\n";
+            return 1;
+        }
+        SchemeImageBuilder builder;
+        builder.beginScheme(src.name);
+        if (!Dictionary::parseSchemeText(path, builder))
+            return 1;
+        auto image = SchemeImage::fromBytes(builder.finish());
+        src.dict = std::make_unique<Dictionary>();
+        if (!image || !src.dict->loadScheme(image, 0)) {
+            std::cerr << "Cannot compile " << path << "\n";
+            return 1;
+        }
+        for (auto it = image->keysBegin(0); it != image->keysEnd(0); ++it)
+            src.keys.emplace_back(image->key(*it));
+        sources.push_back(std::move(src));
+    }
+
+    // 值表：所有字库的不同值按码点排序，下标就是驻留编号
+    std::vector<std::u32string> values;
+    for (const auto& src : sources) {
+        for (const auto& key : src.keys) {
+            for (const DictEntry& e : src.dict->Lookup(key)) values.emplace_back(e.value);
+        }
+    }
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    auto valueId = [&](std::u32string_view v) {
+        return static_cast<uint32_t>(std::lower_bound(values.begin(), values.end(), v) - values.begin());
+    };
+
+    // 键表：按文本排序，同一个键的各字库记录按参数顺序相邻
+    struct KeyRecord {
+        std::string text;
+        uint32_t scheme;
+        uint32_t value_begin;
+        uint32_t value_count;
+    };
+    std::vector<KeyRecord> keys;
+    std::vector<DictEntry> entries;
+    std::map<std::string, std::vector<uint32_t>> byText;  // 文本 -> 各字库编号
+    for (uint32_t s = 0; s < sources.size(); ++s) {
+        for (const auto& key : sources[s].keys) byText[key].push_back(s);
+    }
+    std::vector<uint32_t> shared;
+    for (const auto& [text, schemes] : byText) {
+        if (schemes.size() > 255) {
+            std::cerr << "Too many schemes share the key " << text << "\n";
+            return 1;
+        }
+        if (schemes.size() > 1) shared.push_back(static_cast<uint32_t>(keys.size()));
+        for (uint32_t s : schemes) {
+            KeyRecord rec{text, s, static_cast<uint32_t>(entries.size()), 0};
+            for (const DictEntry& e : sources[s].dict->Lookup(text))
+                entries.push_back({e.value, valueId(e.value), e.length, e.identity});
+            rec.value_count = static_cast<uint32_t>(entries.size()) - rec.value_begin;
+            keys.push_back(std::move(rec));
+        }
+    }
+
+    if (keys.empty()) {
+        std::cerr << "No keys in the given schemes\n";
+        return 1;
+    }
+
+    // 前缀树：每个键的每个前缀一个节点，先按出现顺序编临时号
+    struct TempNode {
+        uint32_t parent;  // 临时号
+        unsigned char byte;
+        uint32_t key_begin = UINT32_MAX;
+        uint8_t key_count = 0;
+        uint64_t schemes = 0;  // 子树里的键出自哪几节
+    };
+    std::vector<TempNode> nodes(1);  // 0 为根
+    std::map<std::pair<uint32_t, unsigned char>, uint32_t> children;
+    for (uint32_t k = 0; k < keys.size(); ++k) {
+        uint32_t node = 0;
+        for (char c : keys[k].text) {
+            auto id = std::make_pair(node, static_cast<unsigned char>(c));
+            auto it = children.find(id);
+            if (it == children.end()) {
+                it = children.emplace(id, static_cast<uint32_t>(nodes.size())).first;
+                nodes.push_back({node, static_cast<unsigned char>(c)});
+            }
+            node = it->second;
+        }
+        if (nodes[node].key_count == 0) nodes[node].key_begin = k;
+        ++nodes[node].key_count;
+        for (uint32_t n = node; n != 0; n = nodes[n].parent) nodes[n].schemes |= uint64_t(1) << keys[k].scheme;
+    }
+
+    // 最小完美哈希（hash-and-displace）：节点按前缀哈希分桶，大桶先放，每桶找一个位移 d，
+    // 让桶里的节点都落到空槽位。槽位数等于根以外的节点数，节点的最终编号 = 槽位 + 1
+    std::vector<uint64_t> prefix(nodes.size(), StaticSchemes::kRootHash);
+    for (uint32_t n = 1; n < nodes.size(); ++n)
+        prefix[n] = StaticSchemes::prefixHash(prefix[nodes[n].parent], nodes[n].byte);  // 父节点的临时号总比子节点小
+    {
+        std::vector<uint64_t> sorted(prefix);
+        std::sort(sorted.begin(), sorted.end());
+        if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+            std::cerr << "Two prefixes share a hash; change StaticSchemes::prefixHash\n";
+            return 1;
+        }
+    }
+    const size_t slotCount = nodes.size() - 1;
+    const size_t bucketCount = std::max<size_t>(1, slotCount / 2);
+    std::vector<std::vector<uint32_t>> buckets(bucketCount);
+    for (uint32_t n = 1; n < nodes.size(); ++n)
+        buckets[StaticSchemes::bucketOf(prefix[n], bucketCount)].push_back(n);
+    std::vector<uint32_t> order(bucketCount);
+    for (uint32_t b = 0; b < bucketCount; ++b) order[b] = b;
+    std::stable_sort(order.begin(), order.end(),
+                     [&](uint32_t a, uint32_t b) { return buckets[a].size() > buckets[b].size(); });
+
+    std::vector<uint32_t> displacements(bucketCount, 0);
+    std::vector<uint32_t> finalId(nodes.size(), StaticSchemes::kRoot);
+    std::vector<char> slotUsed(slotCount, 0);
+    std::vector<size_t> slots;
+    for (uint32_t b : order) {
+        const auto& items = buckets[b];
+        if (items.empty()) break;
+        bool ok = false;
+        for (uint32_t disp = 0; disp < (1u << 24) && !ok; ++disp) {
+            slots.clear();
+            ok = true;
+            for (uint32_t n : items) {
+                size_t slot = StaticSchemes::slotOf(prefix[n], disp, slotCount);
+                if (slotUsed[slot] || std::find(slots.begin(), slots.end(), slot) != slots.end()) {
+                    ok = false;
+                    break;
+                }
+                slots.push_back(slot);
+            }
+            if (ok) displacements[b] = disp;
+        }
+        if (!ok) {
+            std::cerr << "Cannot build a perfect hash for " << slotCount << " nodes\n";
+            return 1;
+        }
+        for (size_t i = 0; i < items.size(); ++i) {
+            slotUsed[slots[i]] = 1;
+            finalId[items[i]] = static_cast<uint32_t>(slots[i] + 1);
+        }
+    }
+
+    // 按最终编号排好节点
+    std::vector<StaticSchemes::Node> table(nodes.size());
+    const uint64_t all = sources.size() == 64 ? ~uint64_t(0) : (uint64_t(1) << sources.size()) - 1;
+    table[0] = {prefix[0], all, StaticSchemes::kNoNode, nodes[0].key_begin, nodes[0].key_count, 0};
+    for (uint32_t n = 1; n < nodes.size(); ++n) {
+        table[finalId[n]] = {prefix[n], nodes[n].schemes, finalId[nodes[n].parent], nodes[n].key_begin,
+                             nodes[n].key_count, nodes[n].byte};
+    }
+
+    // 自查：每个键都能用查表的方式走到，且节点上的记录就是它
+    StaticSchemes check{};
+    check.nodes = table.data();
+    check.node_count = table.size();
+    check.displacements = displacements.data();
+    check.bucket_count = bucketCount;
+    for (uint32_t k = 0; k < keys.size(); ++k) {
+        uint32_t node = check.findNode(keys[k].text);
+        if (node == StaticSchemes::kNoNode || k < table[node].key_begin || k >= table[node].key_begin + table[node].key_count) {
+            std::cerr << "Self-check failed for key " << keys[k].text << "\n";
+            return 1;
+        }
+    }
+
+    std::ostringstream out;
+    out << "#pragma once\n"
+        << "// 由 src/tools/gen_builtin_schemes.cpp 生成，不要手改。自带字库改了以后重新生成：\n"
+        << "//   gen_builtin_schemes schemes src/core/BuiltinSchemes.hpp";
+    for (const auto& src : sources) out << ' ' << src.name;
+    out << "\n"
+        << "// " << sources.size() << " schemes, " << keys.size() << " keys, " << table.size() << " nodes, "
+        << values.size() << " values\n"
+        << "#include \"Dic.hpp\"\n\n";
+
+    out << "inline constexpr StaticSchemes::Scheme kBuiltinSchemeSources[] = {\n";
+    for (const auto& src : sources) {
+        out << "    {" << quoteBytes(src.name) << ", " << src.bytes.size() << "u, 0x" << std::hex
+            << StaticSchemes::fingerprint(src.bytes) << std::dec << "ull},\n";
+    }
+    out << "};\n\n";
+
+    out << "inline constexpr std::u32string_view kBuiltinSchemeValues[] = {\n";
+    for (const auto& v : values)
+        out << "    {" << quoteValue(v) << ", " << v.size() << "},\n";
+    out << "};\n\n";
+
+    out << "inline constexpr DictEntry kBuiltinSchemeEntries[] = {\n";
+    for (const auto& e : entries) {
+        out << "    {kBuiltinSchemeValues[" << e.value_id << "], " << e.value_id << ", " << e.length << ", "
+            << (e.identity ? "true" : "false") << "},\n";
+    }
+    out << "};\n\n";
+
+    out << "inline constexpr StaticSchemes::Key kBuiltinSchemeKeys[] = {\n";
+    for (const auto& k : keys) {
+        out << "    {{" << quoteBytes(k.text) << ", " << k.text.size() << "}, " << k.scheme << ", " << k.value_begin
+            << ", " << k.value_count << ", " << Dictionary::tDigitCount(k.text) << "},\n";
+    }
+    out << "};\n\n";
+
+    out << "inline constexpr StaticSchemes::Node kBuiltinSchemeNodes[] = {";
+    for (size_t i = 0; i < table.size(); ++i) {
+        const auto& n = table[i];
+        char hash[24];
+        std::snprintf(hash, sizeof(hash), "0x%016llxull", static_cast<unsigned long long>(n.hash));
+        out << (i % 2 == 0 ? "\n    " : " ") << "{" << hash << ", 0x" << std::hex << n.schemes << std::dec << ", "
+            << (n.parent == StaticSchemes::kNoNode ? "StaticSchemes::kNoNode" : std::to_string(n.parent)) << ", "
+            << (n.key_count ? n.key_begin : 0) << ", " << unsigned(n.key_count) << ", " << unsigned(n.byte) << "},";
+    }
+    out << "\n};\n\n";
+
+    out << "inline constexpr uint32_t kBuiltinSchemeDisplacements[] = {";
+    for (size_t i = 0; i < displacements.size(); ++i)
+        out << (i % 12 == 0 ? "\n    " : " ") << displacements[i] << ",";
+    out << "\n};\n\n";
+
+    if (!shared.empty()) {
+        out << "inline constexpr uint32_t kBuiltinSchemeSharedKeys[] = {";
+        for (size_t i = 0; i < shared.size(); ++i) out << (i % 12 == 0 ? "\n    " : " ") << shared[i] << ",";
+        out << "\n};\n\n";
+    }
+
+    out << "inline constexpr StaticSchemes kBuiltinSchemes{\n"
+        << "    kBuiltinSchemeSources, " << sources.size() << ",\n"
+        << "    kBuiltinSchemeNodes, " << table.size() << ",\n"
+        << "    kBuiltinSchemeDisplacements, " << displacements.size() << ",\n"
+        << "    kBuiltinSchemeKeys, " << keys.size() << ",\n"
+        << "    kBuiltinSchemeEntries, " << entries.size() << ",\n"
+        << "    kBuiltinSchemeValues, " << values.size() << ",\n"
+        << "    " << (shared.empty() ? "nullptr" : "kBuiltinSchemeSharedKeys") << ", " << shared.size() << ",\n"
+        << "};\n";
+
+    // 内容没变就不改写，免得每次构建都让依赖它的文件重新编译
+    std::string existing;
+    if (readFile(outPath, existing) && existing == out.str()) {
+        std::cout << outPath << " is up to date\n";
+        return 0;
+    }
+    if (checkOnly) {
+        std::cerr << outPath << " is out of date; regenerate it from the schemes and commit it\n";
+        return 1;
+    }
+    std::ofstream fout(outPath, std::ios::binary | std::ios::trunc);
+    fout << out.str();
+    if (!fout) {
+        std::cerr << "Cannot write " << outPath << "\n";
+        return 1;
+    }
+    std::cout << "Wrote " << outPath << ": " << sources.size() << " schemes, " << keys.size() << " keys, "
+              << table.size() << " nodes\n";
+    return 0;
+}
@@ -1,5 +1,6 @@
 #include "CandidateWindow.h"
 #include "TextService.h"
+#include "../core/Trace.hpp"
 #include <strsafe.h>
 #ifdef max
 #undef max
@@ -38,6 +39,8 @@ CCandidateWindow::CCandidateWindow(CTextService* pTextService)
     _selectedIndex = 0;
     _pageIndex = 0;
     _itemsPerPage = 8;
+    _hasMore = FALSE;
+    _stale = FALSE;
     
     InitializeGdiplus();
 }
@@ -110,11 +113,13 @@ void CCandidateWindow::Move(int x, int y)
     }
 }
 
-void CCandidateWindow::Update(const std::vector<std::wstring>& candidates, int selected, int pageIndex)
+void CCandidateWindow::Update(const std::vector<std::wstring>& candidates, int selected, int pageIndex, BOOL hasMore)
 {
     _candidates = candidates;
     _selectedIndex = selected;
     _pageIndex = pageIndex;
+    _hasMore = hasMore;
+    _stale = FALSE;
     
     if (_hwnd)
     {
@@ -122,32 +127,42 @@ void CCandidateWindow::Update(const std::vector<std::wstring>& candidates, int s
     }
 }
 
-void CCandidateWindow::NextPage()
+void CCandidateWindow::LoadPage(int pageIndex)
 {
-    int totalPages = GetTotalPages();
-    if (_pageIndex < totalPages - 1)
+    SCRIPA_TRACE_SCOPE(Window);
+    // Ask for one extra item to know whether a next page exists
+    size_t offset = (size_t)pageIndex * _itemsPerPage;
+    // 这一页还没算好：后台去算，先把窗口标成过时，结果到了 _OnCandidatesReady 再来取
+    if (!_pTextService->_backend.RequestCandidates(offset + _itemsPerPage + 1))
     {
-        _pageIndex++;
+        _pageIndex = pageIndex;
+        _stale = TRUE;
         if (_hwnd)
             InvalidateRect(_hwnd, NULL, TRUE);
+        return;
     }
+    auto items = _pTextService->_backend.GetCandidates(offset, _itemsPerPage + 1);
+    BOOL hasMore = (int)items.size() > _itemsPerPage;
+    if (hasMore)
+        items.resize(_itemsPerPage);
+    Update(items, 0, pageIndex, hasMore);
 }
 
-void CCandidateWindow::PrevPage()
+void CCandidateWindow::NextPage()
 {
-    if (_pageIndex > 0)
+    // 过时的页还不知道后面有没有
+    if (_hasMore && !_stale)
     {
-        _pageIndex--;
-        if (_hwnd)
-            InvalidateRect(_hwnd, NULL, TRUE);
+        LoadPage(_pageIndex + 1);
     }
 }
 
-int CCandidateWindow::GetTotalPages() const
+void CCandidateWindow::PrevPage()
 {
-    if (_candidates.empty())
-        return 1;
-    return (_candidates.size() + _itemsPerPage - 1) / _itemsPerPage;
+    if (_pageIndex > 0)
+    {
+        LoadPage(_pageIndex - 1);
+    }
 }
 
 LRESULT CALLBACK CCandidateWindow::_WindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
@@ -184,6 +199,13 @@ LRESULT CALLBACK CCandidateWindow::_WindowProc(HWND hwnd, UINT msg, WPARAM wPara
         }
         return 0;
 
+    case WM_SCRIPA_CANDIDATES_READY:
+        if (pThis)
+        {
+            pThis->_pTextService->_OnCandidatesReady();
+        }
+        return 0;
+
     case WM_DESTROY:
         return 0;
     }
@@ -193,6 +215,7 @@ LRESULT CALLBACK CCandidateWindow::_WindowProc(HWND hwnd, UINT msg, WPARAM wPara
 
 void CCandidateWindow::_OnPaint(HDC hdc)
 {
+    SCRIPA_TRACE_SCOPE(Paint);
     RECT rc;
     GetClientRect(_hwnd, &rc);
 
@@ -214,31 +237,28 @@ void CCandidateWindow::_OnPaint(HDC hdc)
     std::wstring comp = L"Buffer: " + _composition;
     DrawTextW(hdc, comp.c_str(), (int)comp.size(), &compRc, DT_LEFT | DT_VCENTER | DT_SINGLELINE);
 
-    // Draw candidates
-    int itemCount = (int)_candidates.size();
-    int start = _pageIndex * _itemsPerPage;
-    int shown = std::min(_itemsPerPage, std::max(0, itemCount - start));
+    // Draw candidates (_candidates holds the current page only)
+    int shown = std::min(_itemsPerPage, (int)_candidates.size());
     int padding = 8;
     int itemW = std::max(48, (int)((rc.right - rc.left - padding * shown) / std::max(1, shown)));
     int itemH = 36;
 
     for (int i = 0; i < shown; ++i)
     {
-        int idx = start + i;
         int left = padding + i * (itemW + padding);
         int top = 35;
         RECT it = { left, top, left + itemW, top + itemH };
 
         // Background
-        COLORREF bgColor = (idx == _selectedIndex) ? RGB(0, 120, 215) : RGB(255, 255, 255);
+        COLORREF bgColor = (i == _selectedIndex) ? RGB(0, 120, 215) : RGB(255, 255, 255);
         HBRUSH hbr = CreateSolidBrush(bgColor);
         FillRect(hdc, &it, hbr);
         FrameRect(hdc, &it, (HBRUSH)GetStockObject(BLACK_BRUSH));
         DeleteObject(hbr);
 
-        // Text
-        SetTextColor(hdc, (idx == _selectedIndex) ? RGB(255, 255, 255) : RGB(0, 0, 0));
-        DrawTextW(hdc, _candidates[idx].c_str(), (int)_candidates[idx].size(), &it, DT_CENTER | DT_VCENTER | DT_SINGLELINE);
+        // Text (grey while the page is stale)
+        SetTextColor(hdc, _stale ? RGB(160, 160, 160) : (i == _selectedIndex) ? RGB(255, 255, 255) : RGB(0, 0, 0));
+        DrawTextW(hdc, _candidates[i].c_str(), (int)_candidates[i].size(), &it, DT_CENTER | DT_VCENTER | DT_SINGLELINE);
 
         // Index number
         RECT numRc = { left + 4, top + 4, left + 24, top + 20 };
@@ -248,10 +268,9 @@ void CCandidateWindow::_OnPaint(HDC hdc)
         DrawTextW(hdc, szNum, (int)wcslen(szNum), &numRc, DT_LEFT | DT_TOP | DT_SINGLELINE);
     }
 
-    // Page indicator
-    int totalPages = (itemCount + _itemsPerPage - 1) / _itemsPerPage;
+    // Page indicator: later pages are not searched until requested, so only say whether more exist
     WCHAR szPage[32];
-    StringCchPrintfW(szPage, 32, L"Page %d/%d", _pageIndex + 1, std::max(1, totalPages));
+    StringCchPrintfW(szPage, 32, _stale ? L"Page %d \x2026" : _hasMore ? L"Page %d \x25B8" : L"Page %d", _pageIndex + 1);
     RECT pageRc = { rc.left + 10, 35 + itemH + 8, rc.right - 10, 35 + itemH + 24 };
     SetTextColor(hdc, RGB(80, 80, 80));
     DrawTextW(hdc, szPage, (int)wcslen(szPage), &pageRc, DT_CENTER | DT_VCENTER | DT_SINGLELINE);
@@ -265,16 +284,13 @@ void CCandidateWindow::_OnLButtonDown(int x, int y)
     RECT rc;
     GetClientRect(_hwnd, &rc);
     
-    int itemCount = (int)_candidates.size();
-    int start = _pageIndex * _itemsPerPage;
-    int shown = std::min(_itemsPerPage, std::max(0, itemCount - start));
+    int shown = std::min(_itemsPerPage, (int)_candidates.size());
     int padding = 8;
     int itemW = std::max(48, (int)((rc.right - rc.left - padding * shown) / std::max(1, shown)));
     int itemH = 36;
 
     for (int i = 0; i < shown; ++i)
     {
-        int idx = start + i;
         int left = padding + i * (itemW + padding);
         int top = 35;
         RECT it = { left, top, left + itemW, top + itemH };
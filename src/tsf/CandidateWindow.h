@@ -7,6 +7,9 @@
 
 class CTextService;
 
+// 后台候选算好、或字库热重载后由后台线程投递给候选窗口，在界面线程上刷新
+static const UINT WM_SCRIPA_CANDIDATES_READY = WM_APP + 1;
+
 // Candidate Window - displays IPA conversion candidates
 class CCandidateWindow
 {
@@ -18,11 +21,13 @@ public:
     void Destroy();
     void Show(BOOL bShow);
     void Move(int x, int y);
-    void Update(const std::vector<std::wstring>& candidates, int selected, int pageIndex = 0);
+    void Update(const std::vector<std::wstring>& candidates, int selected, int pageIndex = 0, BOOL hasMore = FALSE);
+    void LoadPage(int pageIndex);  // Show one page of candidates; not searched yet: ask the backend and mark the page stale
     void NextPage();
     void PrevPage();
     int GetCurrentPage() const { return _pageIndex; }
-    int GetTotalPages() const;
+    int GetItemsPerPage() const { return _itemsPerPage; }
+    BOOL IsStale() const { return _stale; }
     
     HWND GetWnd() { return _hwnd; }
     
@@ -33,8 +38,10 @@ private:
     
     CTextService* _pTextService;
     HWND _hwnd;
-    std::vector<std::wstring> _candidates;
+    std::vector<std::wstring> _candidates;  // Current page only
     int _selectedIndex;
+    BOOL _hasMore;                         // More candidates after this page
+    BOOL _stale;                           // _candidates is not this page yet: waiting for WM_SCRIPA_CANDIDATES_READY
     
     // UI state
     std::wstring _composition;
@@ -1,8 +1,8 @@
 #include "ScripaTSF.h"
 #include "../core/Loader.hpp"
 #include "../core/Dic.hpp"
-#include <locale>
-#include <codecvt>
+#include "../core/Utf.hpp"
+#include "../core/Trace.hpp"
 #include <filesystem>
 #include <iostream>
 
@@ -14,26 +14,93 @@ ScripaTSF::ScripaTSF()
 
 ScripaTSF::~ScripaTSF()
 {
+    if (initial_load_.joinable())
+        initial_load_.join();
 }
 
 bool ScripaTSF::Init()
 {
-    // 使用 SchemeLoader 加载所有已启用的字库
-    int count = loader_.loadSchemes(schemes_path_, dict_);
-    std::cout << "[ScripaTSF] Loaded " << count << " scheme file(s)\n";
+    // 先只用编进程序的自带字库：不读任何文件，激活后马上就能打字。
+    // 目录里的字库（custom.txt 等）在后台加载，顺带核对自带字库的文件没改过，好了再换上
+    int count = 0;
+    auto builtin = std::make_shared<Dictionary>();
+    {
+        std::lock_guard<std::mutex> lock(loader_mutex_);
+        count = loader_.attachBuiltinSchemes(*builtin, schemes_path_);
+    }
+    if (count > 0) {
+        shared_dict_.publish(std::move(builtin));
+        AdoptLatestDictionary();
+        std::cout << "[ScripaTSF] Using " << count << " built-in scheme(s), loading " << schemes_path_ << " in the background\n";
+        initial_load_ = std::thread([this] {
+            int loaded = 0;
+            auto dict = BuildDictionary(loaded);
+            if (loaded == 0)
+                return;  // 目录读不到时继续用自带字库
+            shared_dict_.publish(std::move(dict));
+            std::cout << "[ScripaTSF] Loaded " << loaded << " scheme file(s)\n";
+            NotifyReady();
+        });
+    } else {
+        // 没有启用任何自带字库：照旧在这里加载
+        shared_dict_.publish(BuildDictionary(count));
+        AdoptLatestDictionary();
+        std::cout << "[ScripaTSF] Loaded " << count << " scheme file(s)\n";
+    }
+
+    // 选词记录打不开（如目录只读）时只记在内存里，照常输入
+    history_.open(history_path_);
+    engine_.setHistory(&history_);
+
+    // 字库文件（尤其是用户随手编辑的 custom.txt）一改就在后台重建
+    watcher_ = std::make_unique<SchemeWatcher>(schemes_path_, [this] { OnSchemesChanged(); });
     return count > 0;
 }
 
 void ScripaTSF::Uninit()
 {
-    // nothing to free for now
+    if (initial_load_.joinable())
+        initial_load_.join();
+    watcher_.reset();
 }
 
-static std::wstring utf8_to_wstring(const std::string &s)
+std::shared_ptr<const Dictionary> ScripaTSF::BuildDictionary(int& count)
 {
-    // simple converter for common cases; for production use a proper UTF-8->UTF-16 conversion
-    std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> conv;
-    return conv.from_bytes(s);
+    std::lock_guard<std::mutex> build(build_mutex_);
+    SchemeLoader loader;
+    {
+        std::lock_guard<std::mutex> lock(loader_mutex_);
+        loader = loader_;
+    }
+    // 从当前发布的字典接过各层，只增删有变化的层，不重新读没变的字库
+    auto dict = std::make_shared<Dictionary>();
+    if (auto current = shared_dict_.load())
+        dict->setLayers(current->layers());
+    count = loader.loadSchemes(schemes_path_, *dict);
+    return dict;
+}
+
+void ScripaTSF::OnSchemesChanged()
+{
+    int count = 0;
+    auto dict = BuildDictionary(count);
+    // 文件删改到一半、一个字库都没读到时保留旧字典，不发布空字典
+    if (count == 0)
+        return;
+    shared_dict_.publish(std::move(dict));
+    std::cout << "[ScripaTSF] Reloaded " << count << " scheme file(s) after a file change\n";
+    NotifyReady();
+}
+
+bool ScripaTSF::AdoptLatestDictionary()
+{
+    auto latest = shared_dict_.load();
+    if (latest == dict_)
+        return false;
+    // 旧快照若还在后台请求里用着，由那边最后释放
+    dict_ = std::move(latest);
+    engine_.setDictionary(dict_.get());
+    return true;
 }
 
 bool ScripaTSF::OnKeyDown(wchar_t ch)
@@ -41,6 +108,7 @@ bool ScripaTSF::OnKeyDown(wchar_t ch)
     // Only handle basic ASCII input here for the skeleton
     if (ch >= 0 && ch <= 127) {
         char c = static_cast<char>(ch);
+        AdoptLatestDictionary();
         bool handled = engine_.inputChar(c);
         return handled;
     }
@@ -65,13 +133,17 @@ std::wstring ScripaTSF::GetComposition() const
     return utf8_to_wstring(engine_.getBuffer());
 }
 
-std::vector<std::wstring> ScripaTSF::GetCandidates() const
+static std::vector<std::wstring> to_display(const std::vector<std::u32string>& cands)
 {
-    auto cands = engine_.getCandidates();
+    SCRIPA_TRACE_SCOPE(Transcode);
     std::vector<std::wstring> out;
     out.reserve(cands.size());
     for (auto &u32 : cands) {
-        // 过滤掉 U+25CC (虚圆圈占位符)
+        // 过滤掉 U+25CC (虚圆圈占位符)，没有就直接转
+        if (u32.find(U'\u25CC') == std::u32string::npos) {
+            out.push_back(utf32_to_wstring(u32));
+            continue;
+        }
         std::u32string filtered;
         filtered.reserve(u32.size());
         for (char32_t ch : u32) {
@@ -79,27 +151,135 @@ std::vector<std::wstring> ScripaTSF::GetCandidates() const
                 filtered.push_back(ch);
             }
         }
-        
-        // convert UTF-32 -> UTF-8 -> UTF-16
-        std::string utf8 = utf32_to_utf8(filtered);
-        out.push_back(utf8_to_wstring(utf8));
+        // UTF-32 -> UTF-16 直接转换，不经过 UTF-8
+        out.push_back(utf32_to_wstring(filtered));
     }
     return out;
 }
 
+const std::vector<std::wstring>& ScripaTSF::CachedCandidates(size_t count) const
+{
+    // 缓存键：引擎状态版本（buffer、mode）+ 字典版本（ReloadSchemes）
+    if (cache_.engine_version != engine_.version() || cache_.dict_generation != DictGeneration()) {
+        cache_.engine_version = engine_.version();
+        cache_.dict_generation = DictGeneration();
+        cache_.items.clear();
+        cache_.values.clear();
+        cache_.complete = false;
+    }
+    if (!cache_.complete && cache_.items.size() < count) {
+        size_t missing = count - cache_.items.size();
+        auto values = engine_.candidates(missing, cache_.items.size());
+        auto more = to_display(values);
+        if (more.size() < missing) cache_.complete = true;
+        cache_.items.insert(cache_.items.end(),
+                            std::make_move_iterator(more.begin()), std::make_move_iterator(more.end()));
+        cache_.values.insert(cache_.values.end(),
+                             std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()));
+    }
+    return cache_.items;
+}
+
+bool ScripaTSF::IsCached(size_t count) const
+{
+    return cache_.engine_version == engine_.version() && cache_.dict_generation == DictGeneration() &&
+           (cache_.complete || cache_.items.size() >= count);
+}
+
+bool ScripaTSF::RequestCandidates(size_t count)
+{
+    AdoptLatestDictionary();
+    // ENG 模式没有候选，同步路径直接返回空
+    if (IsCached(count) || engine_.getMode() != Engine::Mode::IPA)
+        return true;
+    worker_.submit({engine_.version(), dict_, std::string(engine_.activeBuffer()), engine_.committed(), count,
+                    engine_.beamWidth()});
+    return false;
+}
+
+void ScripaTSF::SetCandidatesReadyCallback(std::function<void()> callback)
+{
+    std::lock_guard<std::mutex> lock(ready_mutex_);
+    on_ready_ = std::move(callback);
+}
+
+void ScripaTSF::OnWorkerResult(CandidateWorker::Result&& result)
+{
+    // 转码也在工作线程上做完
+    ReadyCandidates ready{result.tag, to_display(result.items), std::move(result.items), result.complete};
+    {
+        std::lock_guard<std::mutex> lock(ready_mutex_);
+        ready_ = std::move(ready);
+    }
+    NotifyReady();
+}
+
+void ScripaTSF::NotifyReady()
+{
+    std::lock_guard<std::mutex> lock(ready_mutex_);
+    if (on_ready_) on_ready_();
+}
+
+bool ScripaTSF::ApplyReadyCandidates()
+{
+    std::optional<ReadyCandidates> ready;
+    {
+        std::lock_guard<std::mutex> lock(ready_mutex_);
+        ready.swap(ready_);
+    }
+    if (!ready || ready->engine_version != engine_.version())
+        return false;
+    // 同步路径可能已经算得更多，只在缓存更少时替换
+    bool valid = cache_.engine_version == engine_.version() && cache_.dict_generation == DictGeneration();
+    if (!valid || (!cache_.complete && cache_.items.size() < ready->items.size())) {
+        cache_.engine_version = engine_.version();
+        cache_.dict_generation = DictGeneration();
+        cache_.items = std::move(ready->items);
+        cache_.values = std::move(ready->values);
+        cache_.complete = ready->complete;
+    }
+    return true;
+}
+
+std::vector<std::wstring> ScripaTSF::GetCandidates() const
+{
+    const auto& items = CachedCandidates(Engine::kMaxCandidates);
+    size_t n = std::min(items.size(), Engine::kMaxCandidates);
+    return std::vector<std::wstring>(items.begin(), items.begin() + n);
+}
+
+bool ScripaTSF::HasCandidates() const
+{
+    // 非空的输入码总有原样输出的那一个候选；只剩已提交部分时它自己就是候选
+    return dict_ && engine_.getMode() == Engine::Mode::IPA &&
+           (!engine_.activeBuffer().empty() || !engine_.committed().empty());
+}
+
+std::vector<std::wstring> ScripaTSF::GetCandidates(size_t offset, size_t count) const
+{
+    const auto& items = CachedCandidates(offset + count);
+    if (offset >= items.size())
+        return {};
+    size_t end = std::min(items.size(), offset + count);
+    return std::vector<std::wstring>(items.begin() + offset, items.begin() + end);
+}
+
 // 字库管理接口实现
 void ScripaTSF::EnableScheme(const std::string& schemeName)
 {
+    std::lock_guard<std::mutex> lock(loader_mutex_);
     loader_.enableScheme(schemeName);
 }
 
 void ScripaTSF::DisableScheme(const std::string& schemeName)
 {
+    std::lock_guard<std::mutex> lock(loader_mutex_);
     loader_.disableScheme(schemeName);
 }
 
 bool ScripaTSF::IsSchemeEnabled(const std::string& schemeName) const
 {
+    std::lock_guard<std::mutex> lock(loader_mutex_);
     return loader_.isSchemeEnabled(schemeName);
 }
 
@@ -110,16 +290,16 @@ std::vector<std::string> ScripaTSF::GetAvailableSchemes() const
 
 std::vector<std::string> ScripaTSF::GetEnabledSchemes() const
 {
+    std::lock_guard<std::mutex> lock(loader_mutex_);
     return loader_.getEnabledSchemes();
 }
 
 bool ScripaTSF::ReloadSchemes()
 {
-    // 清空当前字典
-    dict_.clear();
-    
-    // 重新加载所有启用的字库
-    int count = loader_.loadSchemes(schemes_path_, dict_);
+    // 另建一份再替换：后台请求和还没换过去的读者继续用旧快照
+    int count = 0;
+    shared_dict_.publish(BuildDictionary(count));
+    AdoptLatestDictionary();
     std::cout << "[ScripaTSF] Reloaded " << count << " scheme file(s)\n";
     
     // 清空当前输入缓冲
@@ -133,28 +313,17 @@ std::wstring ScripaTSF::GetBuffer() const
     return utf8_to_wstring(engine_.getBuffer());
 }
 
-void ScripaTSF::SelectCandidate(int index)
+void ScripaTSF::SelectCandidate(int index, bool remember)
 {
-    auto candidates = engine_.getCandidates();
-    if (index >= 0 && index < (int)candidates.size())
+    if (index < 0)
+        return;
+    // 与候选窗口共用缓存，不再重新搜索
+    CachedCandidates((size_t)index + 1);
+    if (index < (int)cache_.values.size())
     {
-        // Get selected candidate
-        const auto& selected = candidates[index];
-        
-        // Filter out U+25CC
-        std::u32string filtered;
-        for (char32_t ch : selected) {
-            if (ch != 0x25CC) {
-                filtered.push_back(ch);
-            }
-        }
-        
-        // Convert to UTF-8 then commit
-        std::string utf8 = utf32_to_utf8(filtered);
-        
         // Commit the selected candidate and clear buffer
         // Note: In TSF context, the actual insertion is handled by TextService
-        // This just clears the engine state
-        engine_.clearBuffer();
+        // This records the choice (if asked to) and clears the engine state
+        engine_.acceptCandidate(cache_.values[(size_t)index], remember);
     }
 }
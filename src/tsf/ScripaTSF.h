@@ -2,7 +2,15 @@
 #include "../core/Dic.hpp"
 #include "../core/Engine.hpp"
 #include "../core/Loader.hpp"
+#include "../core/CandidateWorker.hpp"
+#include "../core/UserHistory.hpp"
+#include "../core/SchemeWatcher.hpp"
+#include <memory>
+#include <functional>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 
 // Minimal non-COM skeleton that shows where TSF integration should call into the engine.
@@ -14,6 +22,7 @@ public:
     ~ScripaTSF();
 
     // Initialize dictionary and engine. Returns false on failure.
+    // 编进程序的自带字库立刻可用；目录里的字库在后台加载，好了之后和字库文件改动一样发布并回调
     bool Init();
     void Uninit();
 
@@ -34,12 +43,31 @@ public:
 
     // Get candidates (UTF-16) for UI display
     std::vector<std::wstring> GetCandidates() const;
+
+    // 不搜索就知道有没有候选（翻页、空格提交前判断用）
+    bool HasCandidates() const;
+
+    // Get one page of candidates: only searches as far as offset + count
+    std::vector<std::wstring> GetCandidates(size_t offset, size_t count) const;
     
-    // Select a candidate by index
-    void SelectCandidate(int index);
+    // 后台计算前 count 个候选，不阻塞按键处理。缓存里已经有了就返回 true，调用方可以直接 GetCandidates；
+    // 否则返回 false，算好后调用 SetCandidatesReadyCallback 设的回调
+    bool RequestCandidates(size_t count);
+
+    // 后台候选算好、或字库文件改动后新字典已发布时调用（在后台线程上，只应投递消息回界面线程）。传空函数取消
+    void SetCandidatesReadyCallback(std::function<void()> callback);
+
+    // 在界面线程上换用最新发布的字典；换了返回 true（候选缓存随之失效，需要重新请求）
+    bool AdoptLatestDictionary();
+
+    // 在界面线程上把后台结果装进候选缓存；结果对应的输入已经过时则丢弃并返回 false
+    bool ApplyReadyCandidates();
+
+    // Select a candidate by index (clears the buffer; records the choice in the user history when remember is set)
+    void SelectCandidate(int index, bool remember);
 
     // 缓冲区操作
-    void deleteLastChar() { engine_.deleteLastChar(); }
+    void deleteLastChar() { AdoptLatestDictionary(); engine_.deleteLastChar(); }
     void clearBuffer() { engine_.clearBuffer(); }
     
     // Get current mode (true = IPA, false = ENG)
@@ -52,12 +80,57 @@ public:
     std::vector<std::string> GetAvailableSchemes() const;
     std::vector<std::string> GetEnabledSchemes() const;
     
-    // 重新加载字库（在更改字库设置后调用）
+    // 重新加载字库（在更改字库设置后调用）。新字典建好后才替换，期间旧字典照常可用
     bool ReloadSchemes();
 
+    // 束搜索宽度（scripa_config.ini 的 beamWidth），0 为精确搜索
+    void SetBeamWidth(size_t width) { engine_.setBeamWidth(width); }
+    size_t GetBeamWidth() const { return engine_.beamWidth(); }
+
 private:
-    Dictionary dict_;
-    Engine engine_ { &dict_ };
+    // 一次按键里会多次取候选（翻页判断、空格、刷新窗口、选词），只在引擎状态或字典变化后才重新计算和转码
+    struct CandidateCache {
+        uint64_t engine_version = UINT64_MAX;
+        uint64_t dict_generation = UINT64_MAX;
+        std::vector<std::wstring> items;  // 按排名已转换好的前若干个候选
+        std::vector<std::u32string> values;  // 同样的候选未经转换，选词时原样交回引擎
+        bool complete = false;            // items 已是全部候选
+    };
+
+    // 确保缓存里至少有 count 个候选（或已取完），返回缓存
+    const std::vector<std::wstring>& CachedCandidates(size_t count) const;
+    bool IsCached(size_t count) const;  // 缓存对当前状态有效且已够 count 个
+
+    // 工作线程算好、已转成 UTF-16 的结果，等界面线程来取
+    struct ReadyCandidates {
+        uint64_t engine_version;
+        std::vector<std::wstring> items;
+        std::vector<std::u32string> values;
+        bool complete;
+    };
+    void OnWorkerResult(CandidateWorker::Result&& result);  // 工作线程上调用
+    void NotifyReady();                                     // 调用 on_ready_，任意线程
+
+    // 按当前启用的字库建一份新字典：沿用已发布字典里没变的层（任意线程；同一时间只建一份，schemes.bin 也只由它改写）
+    std::shared_ptr<const Dictionary> BuildDictionary(int& count);
+    void OnSchemesChanged();  // 监视线程上调用：重建并发布
+    uint64_t DictGeneration() const { return dict_ ? dict_->generation() : 0; }
+
+    SharedDictionary shared_dict_;            // 最新发布的字典，监视线程与界面线程共享
+    std::shared_ptr<const Dictionary> dict_;  // 界面线程正在用的快照，engine_ 指向它
+    UserHistory history_;                     // 选词记录：界面线程写，工作线程读
+    Engine engine_ { nullptr };
+    mutable std::mutex loader_mutex_;         // 保护 loader_（启用的字库集合）
     SchemeLoader loader_;
+    std::mutex build_mutex_;                  // 串行化 BuildDictionary
     std::string schemes_path_ = "../schemes/";  // 默认路径（相对于 build/ 目录）
+    std::string history_path_ = "../scripa_history.log";
+    mutable CandidateCache cache_;
+
+    std::mutex ready_mutex_;                 // 保护 ready_ 与 on_ready_
+    std::optional<ReadyCandidates> ready_;
+    std::function<void()> on_ready_;
+    CandidateWorker worker_ { [this](CandidateWorker::Result&& r) { OnWorkerResult(std::move(r)); }, &history_ };
+    std::thread initial_load_;                // Init 之后在后台加载字库目录；Uninit 与析构时等它结束
+    std::unique_ptr<SchemeWatcher> watcher_;  // 最先析构：它的线程会用到上面所有成员
 };
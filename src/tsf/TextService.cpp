@@ -25,6 +25,8 @@ CTextService::CTextService()
     _pContext = NULL;
     _dwThreadMgrEventSinkCookie = TF_INVALID_COOKIE;
     _pComposition = NULL;
+    _pendingPick = -1;
+    _pendingExplicit = false;
     _pCandidateWindow = NULL;
     _pToolbar = NULL;
     
@@ -135,6 +137,12 @@ STDMETHODIMP CTextService::Activate(ITfThreadMgr* pThreadMgr, TfClientId tfClien
         _pCandidateWindow = NULL;
         return E_FAIL;
     }
+
+    // Candidates are computed off the key handler; the worker thread only posts a message back
+    HWND hwndCandidate = _pCandidateWindow->GetWnd();
+    _backend.SetCandidatesReadyCallback([hwndCandidate]() {
+        PostMessage(hwndCandidate, WM_SCRIPA_CANDIDATES_READY, 0, 0);
+    });
     
     _pToolbar = new CToolbar(this);
     if (!_pToolbar->Create())
@@ -152,6 +160,10 @@ STDMETHODIMP CTextService::Activate(ITfThreadMgr* pThreadMgr, TfClientId tfClien
 
 STDMETHODIMP CTextService::Deactivate()
 {
+    // Stop posting to the candidate window before it goes away
+    _backend.SetCandidatesReadyCallback(nullptr);
+    _pendingPick = -1;
+
     // Cleanup UI windows
     if (_pCandidateWindow)
     {
@@ -273,6 +285,9 @@ STDMETHODIMP CTextService::OnKeyDown(ITfContext* pContext, WPARAM wParam, LPARAM
     // Store context
     _pContext = pContext;
 
+    // A pick is still waiting for the worker: it came first, so commit it before this key
+    _FlushPendingPick();
+
     // Check for big keyboard number keys (1-9) - candidate selection
     if (wParam >= '1' && wParam <= '9')
     {
@@ -315,7 +330,7 @@ STDMETHODIMP CTextService::OnKeyDown(ITfContext* pContext, WPARAM wParam, LPARAM
     // Handle page navigation
     if (wParam == VK_PRIOR || wParam == VK_OEM_4)  // PageUp or '['
     {
-        if (_pCandidateWindow && !_backend.GetCandidates().empty())
+        if (_pCandidateWindow && _backend.HasCandidates())
         {
             _pCandidateWindow->PrevPage();
             *pfEaten = TRUE;
@@ -324,7 +339,7 @@ STDMETHODIMP CTextService::OnKeyDown(ITfContext* pContext, WPARAM wParam, LPARAM
     }
     else if (wParam == VK_NEXT || wParam == VK_OEM_6)  // PageDown or ']'
     {
-        if (_pCandidateWindow && !_backend.GetCandidates().empty())
+        if (_pCandidateWindow && _backend.HasCandidates())
         {
             _pCandidateWindow->NextPage();
             *pfEaten = TRUE;
@@ -332,13 +347,12 @@ STDMETHODIMP CTextService::OnKeyDown(ITfContext* pContext, WPARAM wParam, LPARAM
         }
     }
 
-    // Handle space - select first candidate
+    // Handle space - select first candidate (committed once the worker has it)
     if (wParam == VK_SPACE)
     {
-        auto candidates = _backend.GetCandidates();
-        if (!candidates.empty())
+        if (_backend.HasCandidates())
         {
-            _OnCandidateSelected(0);
+            _OnCandidateSelected(0, false);
             *pfEaten = TRUE;
             return S_OK;
         }
@@ -806,7 +820,6 @@ void CTextService::_UpdateCandidateWindow()
         return;
     
     std::wstring buffer = _backend.GetBuffer();
-    auto candidates = _backend.GetCandidates();
     
     if (buffer.empty())
     {
@@ -814,8 +827,41 @@ void CTextService::_UpdateCandidateWindow()
         return;
     }
     
-    _pCandidateWindow->Update(candidates, 0);
+    // Only the first page is searched; later pages are pulled on PageDown.
+    // The search runs in the background so the key handler returns at once;
+    // the old page belongs to the previous input, so hide it until _OnCandidatesReady shows the new one
+    _pCandidateWindow->LoadPage(0);
+    _pCandidateWindow->Show(!_pCandidateWindow->IsStale());
+}
+
+void CTextService::_OnCandidatesReady()
+{
+    if (!_pCandidateWindow)
+        return;
+    // A scheme file changed and a new dictionary was published: recompute with it
+    if (_backend.AdoptLatestDictionary())
+    {
+        _UpdateCandidateWindow();
+        return;
+    }
+    // Results for a stale buffer are dropped; the newer request posts again
+    if (!_backend.ApplyReadyCandidates())
+        return;
+    if (_pendingPick >= 0)
+    {
+        size_t index = (size_t)_pendingPick;
+        _pendingPick = -1;
+        _CommitCandidate(index, _pendingExplicit);
+        return;
+    }
+    if (_backend.GetBuffer().empty())
+        return;
+    // Reload the page that was asked for (PageDown may have moved past page 0)
+    _pCandidateWindow->LoadPage(_pCandidateWindow->GetCurrentPage());
+    if (_pCandidateWindow->IsStale())
+        return;
     _pCandidateWindow->Show(TRUE);
+    _PositionWindows();
 }
 
 void CTextService::_UpdateToolbar()
@@ -875,25 +921,41 @@ void CTextService::_PositionWindows()
     }
 }
 
-void CTextService::_OnCandidateSelected(int index)
+void CTextService::_OnCandidateSelected(int index, bool explicitPick)
 {
     if (!_pContext || !_pCandidateWindow)
         return;
     
-    auto candidates = _backend.GetCandidates();
-    if (candidates.empty())
-        return;
-    
     // Calculate actual index based on current page
     int pageIndex = _pCandidateWindow->GetCurrentPage();
-    int itemsPerPage = 8;  // Match _itemsPerPage in CCandidateWindow
+    int itemsPerPage = _pCandidateWindow->GetItemsPerPage();
     int actualIndex = pageIndex * itemsPerPage + index;
     
-    if (actualIndex < 0 || actualIndex >= (int)candidates.size())
+    if (index < 0 || actualIndex < 0)
+        return;
+
+    _CommitCandidate((size_t)actualIndex, explicitPick);
+}
+
+void CTextService::_CommitCandidate(size_t actualIndex, bool explicitPick)
+{
+    if (!_pContext || !_pCandidateWindow)
+        return;
+
+    // Not searched that far yet: commit when the worker's results arrive (_OnCandidatesReady)
+    if (!_backend.RequestCandidates(actualIndex + 1))
+    {
+        _pendingPick = (int)actualIndex;
+        _pendingExplicit = explicitPick;
+        return;
+    }
+
+    auto candidates = _backend.GetCandidates(actualIndex, 1);
+    if (candidates.empty())
         return;
     
     // Get the selected candidate text
-    std::wstring selectedText = candidates[actualIndex];
+    std::wstring selectedText = candidates[0];
     
     // End composition with the selected text
     if (_pComposition)
@@ -913,16 +975,30 @@ void CTextService::_OnCandidateSelected(int index)
         _EndComposition(_pContext);
     }
     
-    // Clear backend buffer
-    _backend.clearBuffer();
+    // Clear backend buffer. Only remember the choice for ranking when the user actually picked it:
+    // Space on the first page just accepts the top candidate and would otherwise pin it forever
+    _backend.SelectCandidate((int)actualIndex, explicitPick || actualIndex != 0);
     
     // Hide candidate window
     if (_pCandidateWindow)
         _pCandidateWindow->Show(FALSE);
 }
 
+void CTextService::_FlushPendingPick()
+{
+    if (_pendingPick < 0)
+        return;
+    size_t index = (size_t)_pendingPick;
+    _pendingPick = -1;
+    // Rare: only when keys come faster than the search. GetCandidates fills the rest on this thread
+    if (_backend.GetCandidates(index, 1).empty())
+        return;
+    _CommitCandidate(index, _pendingExplicit);
+}
+
 void CTextService::_OnToggleMode()
 {
+    _FlushPendingPick();
     _backend.ToggleMode();
     _UpdateToolbar();
 }
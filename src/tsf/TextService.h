@@ -70,7 +70,10 @@ public:
     void _PositionWindows();
     
     // UI callbacks (called by CandidateWindow and CToolbar)
-    void _OnCandidateSelected(int index);
+    void _OnCandidateSelected(int index, bool explicitPick = true);  // explicitPick: chosen with a digit key or the mouse, not Space
+    void _CommitCandidate(size_t index, bool explicitPick);  // index counts from the first page; waits for the worker if not searched yet
+    void _FlushPendingPick();  // Another key came before the pending pick's results: commit it now, in order
+    void _OnCandidatesReady();  // WM_SCRIPA_CANDIDATES_READY
     void _OnToggleMode();
 
     TfClientId _tfClientId;
@@ -78,6 +81,8 @@ public:
     ITfContext* _pContext;
     DWORD _dwThreadMgrEventSinkCookie;
     ITfComposition* _pComposition;
+    int _pendingPick;           // Candidate chosen before it was searched (-1: none); committed in _OnCandidatesReady
+    bool _pendingExplicit;
     
     // Backend engine
     ScripaTSF _backend;
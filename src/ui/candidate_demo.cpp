@@ -10,13 +10,12 @@
 #include <string>
 #include <sstream>
 #include <algorithm>
-#include <locale>
-#include <codecvt>
 #include <map>
 #include <set>
 #include <fstream>
 #include "../tsf/ScripaTSF.h"
 #include "../core/Dic.hpp"
+#include "../core/Utf.hpp"
 #include <gdiplus.h>
 #include <shellapi.h>
 #pragma comment(lib, "gdiplus.lib")
@@ -468,12 +467,17 @@ void LoadConfig() {
             }
         } else if (key == L"darkMode") {
             g_ui.darkMode = (value == L"1" || value == L"true");
+        } else if (key == L"beamWidth") {
+            // 0 = exact search; >0 keeps that many hypotheses per position (for very long input)
+            int val = _wtoi(value.c_str());
+            if (val >= 0 && val <= 256) {
+                g_backend.SetBeamWidth((size_t)val);
+            }
         } else if (key == L"chordMode") {
             g_ui.chordMode = (value == L"1" || value == L"true");
         } else if (key == L"enabledSchemes") {
             // Parse comma-separated scheme list
-            std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> conv;
-            std::string schemes = conv.to_bytes(value);
+            std::string schemes = wstring_to_utf8(value);
             
             // First disable all schemes
             auto allSchemes = g_backend.GetAvailableSchemes();
@@ -530,15 +534,14 @@ void SaveConfig() {
     file << L"itemsPerPage=" << g_ui.itemsPerPage << L"\n";
     file << L"darkMode=" << (g_ui.darkMode ? L"1" : L"0") << L"\n";
     file << L"chordMode=" << (g_ui.chordMode ? L"1" : L"0") << L"\n";
+    file << L"beamWidth=" << g_backend.GetBeamWidth() << L"\n";
     
-    // Save enabled schemes (exclude chord and chord2 - they're managed by chordMode)
-    auto allSchemes = g_backend.GetAvailableSchemes();
+    // Save enabled schemes in priority order (exclude chord and chord2 - they're managed by chordMode)
     std::wstring enabledSchemes;
-    for (const auto& scheme : allSchemes) {
-        if (scheme != "chord" && scheme != "chord2" && g_backend.IsSchemeEnabled(scheme)) {
-            std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> conv;
+    for (const auto& scheme : g_backend.GetEnabledSchemes()) {
+        if (scheme != "chord" && scheme != "chord2") {
             if (!enabledSchemes.empty()) enabledSchemes += L",";
-            enabledSchemes += conv.from_bytes(scheme);
+            enabledSchemes += utf8_to_wstring(scheme);
         }
     }
     file << L"enabledSchemes=" << enabledSchemes << L"\n";
@@ -738,8 +741,8 @@ LRESULT CALLBACK OtherSettingsDlgProc(HWND hwndDlg, UINT msg, WPARAM wParam, LPA
                 // 1. Save current enabled schemes
                 g_savedEnabledSchemes.clear();
                 auto allSchemes = g_backend.GetAvailableSchemes();
-                for (const auto& scheme : allSchemes) {
-                    if (scheme != "chord" && scheme != "chord2" && g_backend.IsSchemeEnabled(scheme)) {
+                for (const auto& scheme : g_backend.GetEnabledSchemes()) {  // keep priority order
+                    if (scheme != "chord" && scheme != "chord2") {
                         g_savedEnabledSchemes.push_back(scheme);
                     }
                 }
@@ -909,8 +912,7 @@ LRESULT CALLBACK SchemeSelectionDlgProc(HWND hwndDlg, UINT msg, WPARAM wParam, L
             auto& group = g_schemeGroups[gi];
             
             // Group checkbox
-            std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> conv;
-            std::wstring groupName = conv.from_bytes(group.name);
+            std::wstring groupName = utf8_to_wstring(group.name);
             
             group.checkboxGroup = CreateWindowW(
                 L"BUTTON", groupName.c_str(),
@@ -967,8 +969,7 @@ LRESULT CALLBACK SchemeSelectionDlgProc(HWND hwndDlg, UINT msg, WPARAM wParam, L
         // Standalone schemes (e.g., custom)
         for (size_t i = 0; i < g_standaloneSchemes.size(); ++i) {
             bool enabled = g_backend.IsSchemeEnabled(g_standaloneSchemes[i]);
-            std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> conv;
-            std::wstring schemeName = conv.from_bytes(g_standaloneSchemes[i]);
+            std::wstring schemeName = utf8_to_wstring(g_standaloneSchemes[i]);
             
             HWND hwndCheck = CreateWindowW(
                 L"BUTTON", schemeName.c_str(),